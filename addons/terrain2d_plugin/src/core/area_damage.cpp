@@ -0,0 +1,140 @@
+#include "area_damage.h"
+#include <cmath>
+#include <algorithm>
+
+using namespace godot;
+
+DamageShape DamageShape::circle(Vector2i center, float radius) {
+    DamageShape shape;
+    shape.type = CIRCLE;
+    shape.center = center;
+    shape.end = center;
+    shape.radius = radius;
+    return shape;
+}
+
+DamageShape DamageShape::ring(Vector2i center, float inner_radius, float outer_radius) {
+    DamageShape shape;
+    shape.type = RING;
+    shape.center = center;
+    shape.end = center;
+    shape.radius = outer_radius;
+    shape.inner_radius = inner_radius;
+    return shape;
+}
+
+DamageShape DamageShape::capsule(Vector2i start, Vector2i end, float radius) {
+    DamageShape shape;
+    shape.type = CAPSULE;
+    shape.center = start;
+    shape.end = end;
+    shape.radius = radius;
+    return shape;
+}
+
+DamageShape DamageShape::mask(Vector2i origin, Vector2i size, const float* weights) {
+    DamageShape shape;
+    shape.type = MASK;
+    shape.center = origin;
+    shape.end = origin;
+    shape.mask_size = size;
+    shape.mask_weights = weights;
+    return shape;
+}
+
+Rect2i DamageShape::get_tile_bounds() const {
+    if (type == MASK) {
+        return Rect2i(center, mask_size);
+    }
+
+    int r = static_cast<int>(std::ceil(radius));
+    int min_x = std::min(center.x, end.x) - r;
+    int min_y = std::min(center.y, end.y) - r;
+    int max_x = std::max(center.x, end.x) + r;
+    int max_y = std::max(center.y, end.y) + r;
+    return Rect2i(min_x, min_y, max_x - min_x + 1, max_y - min_y + 1);
+}
+
+Vector2i DamageShape::get_origin() const {
+    if (type == MASK) {
+        return center + Vector2i(mask_size.x / 2, mask_size.y / 2);
+    }
+    return center;
+}
+
+void DamageShape::evaluate_row(int tile_y, int tile_x, int count, DamageFalloff falloff, float* out_weights) const {
+    if (type == MASK) {
+        int row = tile_y - center.y;
+        for (int i = 0; i < count; i++) {
+            int col = tile_x + i - center.x;
+            bool inside = row >= 0 && row < mask_size.y && col >= 0 && col < mask_size.x;
+            out_weights[i] = inside ? mask_weights[row * mask_size.x + col] : 0.0f;
+        }
+        return;
+    }
+
+    const float r2 = radius * radius;
+    const float inner2 = (type == RING) ? inner_radius * inner_radius : -1.0f;
+    const float inv_radius = radius > 0.0f ? 1.0f / radius : 0.0f;
+
+    // Squared distance to the shape's core (point or segment)
+    if (type == CAPSULE) {
+        const float ax = static_cast<float>(center.x);
+        const float ay = static_cast<float>(center.y);
+        const float abx = static_cast<float>(end.x - center.x);
+        const float aby = static_cast<float>(end.y - center.y);
+        const float len2 = abx * abx + aby * aby;
+        const float inv_len2 = len2 > 0.0f ? 1.0f / len2 : 0.0f;
+        const float py = static_cast<float>(tile_y) - ay;
+
+        for (int i = 0; i < count; i++) {
+            float px = static_cast<float>(tile_x + i) - ax;
+            float t = std::clamp((px * abx + py * aby) * inv_len2, 0.0f, 1.0f);
+            float dx = px - abx * t;
+            float dy = py - aby * t;
+            out_weights[i] = dx * dx + dy * dy;
+        }
+    } else {
+        const float dy = static_cast<float>(tile_y - center.y);
+        for (int i = 0; i < count; i++) {
+            float dx = static_cast<float>(tile_x + i - center.x);
+            out_weights[i] = dx * dx + dy * dy;
+        }
+    }
+
+    // Squared distance -> weight
+    for (int i = 0; i < count; i++) {
+        float d2 = out_weights[i];
+        float t = std::min(std::sqrt(d2) * inv_radius, 1.0f);
+        float w;
+        switch (falloff) {
+            case FALLOFF_LINEAR:    w = 1.0f - t; break;
+            case FALLOFF_QUADRATIC: w = (1.0f - t) * (1.0f - t); break;
+            case FALLOFF_SMOOTH:    w = 1.0f - t * t * (3.0f - 2.0f * t); break;
+            default:                w = 1.0f; break;
+        }
+        bool inside = d2 <= r2 && d2 >= inner2;
+        out_weights[i] = inside ? w : 0.0f;
+    }
+}
+
+void BlockDamageTable::refresh(const BlockRegistry* registry) {
+    if (!registry || registry->get_version() == registry_version) {
+        return;
+    }
+    registry_version = registry->get_version();
+
+    size_t count = static_cast<size_t>(registry->get_max_block_id()) + 1;
+    damage_reduction.assign(count, 0.0f);
+    max_health.assign(count, 100.0f);
+    required_tool_tier.assign(count, -1);
+
+    for (const auto& [id, def] : registry->get_all_blocks()) {
+        damage_reduction[id] = def.damage_reduction;
+        max_health[id] = def.max_health;
+        required_tool_tier[id] = static_cast<int16_t>(std::clamp(def.required_tool_tier, 0, 0x7FFF));
+    }
+
+    // Air is never damageable
+    required_tool_tier[0] = -1;
+}
@@ -0,0 +1,105 @@
+#ifndef AREA_DAMAGE_H
+#define AREA_DAMAGE_H
+
+#include "../world/block_data.h"
+#include "../world/world_constants.h"
+#include "block_registry.h"
+#include <godot_cpp/variant/vector2i.hpp>
+#include <godot_cpp/variant/vector2.hpp>
+#include <godot_cpp/variant/rect2i.hpp>
+#include <vector>
+#include <cstdint>
+
+using namespace godot;
+
+// How damage fades from the center of a shape to its edge
+enum DamageFalloff : uint8_t {
+    FALLOFF_NONE = 0,      // Full damage everywhere inside the shape
+    FALLOFF_LINEAR,        // 1 - t
+    FALLOFF_QUADRATIC,     // (1 - t)^2, sharp core (explosions)
+    FALLOFF_SMOOTH         // Smoothstep, soft edge
+};
+
+// Shape of an area damage event, in tile coordinates
+// Distances are measured between tile centers. For CAPSULE the distance is to
+// the segment start..end (lasers, drills). MASK uses caller-owned weights and
+// ignores falloff.
+struct DamageShape {
+    enum Type : uint8_t {
+        CIRCLE = 0,
+        RING,
+        CAPSULE,
+        MASK
+    };
+
+    Type type;
+    Vector2i center;            // Circle/ring center, capsule start, mask origin (top-left)
+    Vector2i end;               // Capsule end
+    float radius;               // Outer radius
+    float inner_radius;         // Ring inner radius (tiles closer than this are skipped)
+
+    // Arbitrary mask: mask_size.x * mask_size.y weights, row-major
+    const float* mask_weights;
+    Vector2i mask_size;
+
+    DamageShape()
+        : type(CIRCLE)
+        , radius(0.0f)
+        , inner_radius(0.0f)
+        , mask_weights(nullptr)
+    {}
+
+    static DamageShape circle(Vector2i center, float radius);
+    static DamageShape ring(Vector2i center, float inner_radius, float outer_radius);
+    static DamageShape capsule(Vector2i start, Vector2i end, float radius);
+    static DamageShape mask(Vector2i origin, Vector2i size, const float* weights);
+
+    // Tile bounds covered by the shape (unwrapped X)
+    Rect2i get_tile_bounds() const;
+
+    // Anchor used for occlusion rays (center of circle/ring/mask, start of capsule)
+    Vector2i get_origin() const;
+
+    // Evaluate weights (0..1) for tiles [tile_x, tile_x + count) of row tile_y
+    void evaluate_row(int tile_y, int tile_x, int count, DamageFalloff falloff, float* out_weights) const;
+};
+
+// Parameters for BlockDamageSystem::damage_area
+struct AreaDamageParams {
+    DamageShape shape;
+    float raw_damage;               // Damage at weight 1.0 (before block damage reduction)
+    DamageFalloff falloff;
+    bool scale_after_reduction;     // Weight scales applied damage (splash) instead of raw damage (blasts)
+    bool respect_tool_tier;         // Skip blocks the tool can't mine
+    bool occlusion;                 // Solid blocks between origin and tile shield it
+    bool is_background;             // Damage background layer
+
+    AreaDamageParams()
+        : raw_damage(0.0f)
+        , falloff(FALLOFF_NONE)
+        , scale_after_reduction(false)
+        , respect_tool_tier(true)
+        , occlusion(false)
+        , is_background(false)
+    {}
+};
+
+// Flat per-type damage properties, indexed by block type ID
+// Built from the registry so the area kernel never hashes per tile
+struct BlockDamageTable {
+    std::vector<float> damage_reduction;
+    std::vector<float> max_health;
+    std::vector<int16_t> required_tool_tier;   // -1 for unknown types (not damageable)
+    uint32_t registry_version;
+
+    BlockDamageTable() : registry_version(UINT32_MAX) {}
+
+    // Rebuild if the registry changed since the last build
+    void refresh(const BlockRegistry* registry);
+
+    inline bool is_known(uint16_t type_id) const {
+        return type_id < required_tool_tier.size() && required_tool_tier[type_id] >= 0;
+    }
+};
+
+#endif // AREA_DAMAGE_H
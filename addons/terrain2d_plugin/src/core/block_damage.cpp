@@ -1,5 +1,6 @@
 #include "block_damage.h"
 #include <algorithm>
+#include <cstring>
 
 using namespace godot;
 
@@ -7,7 +8,7 @@ DamageResult BlockDamageSystem::damage_block(Vector2i tile_pos, float raw_damage
     DamageResult result;
     result.destroyed_pos = tile_pos;
 
-    const Block2D* block = chunk_manager->get_block_at_tile(tile_pos, is_background);
+    BlockView block = chunk_manager->get_block_at_tile(tile_pos, is_background);
     if (!block || block->type_id == 0) {
         return result; // No block to damage
     }
@@ -22,6 +23,13 @@ DamageResult BlockDamageSystem::damage_block(Vector2i tile_pos, float raw_damage
         return result; // Tool not strong enough
     }
 
+    // Every tile of a multi-tile object wears down the origin's health
+    Vector2i origin;
+    if (chunk_manager->get_multi_tile_origin(tile_pos, is_background, origin)) {
+        tile_pos = origin;
+        result.destroyed_pos = origin;
+    }
+
     // Calculate actual damage after reduction
     float actual_damage = calculate_actual_damage(raw_damage, def->damage_reduction);
 
@@ -33,75 +41,269 @@ DamageResult BlockDamageSystem::damage_block(Vector2i tile_pos, float raw_damage
 
 std::vector<DamageResult> BlockDamageSystem::damage_3x3_area(Vector2i center_pos, float raw_damage, const Tool& tool) {
     std::vector<DamageResult> results;
+    damage_3x3_area(center_pos, raw_damage, tool, results);
+    return results;
+}
 
-    // Define 3x3 area (center block + 8 surrounding)
-    const Vector2i main_area[9] = {
-        Vector2i(-1, -1), Vector2i(0, -1), Vector2i(1, -1),
-        Vector2i(-1,  0), Vector2i(0,  0), Vector2i(1,  0),
-        Vector2i(-1,  1), Vector2i(0,  1), Vector2i(1,  1)
+void BlockDamageSystem::damage_3x3_area(Vector2i center_pos, float raw_damage, const Tool& tool, std::vector<DamageResult>& out_results) {
+    // 5x5 cursor masks centered on the cursor tile
+    // 3x3 main area (center block + 8 surrounding) takes full damage
+    static const float main_area[25] = {
+        0.0f, 0.0f, 0.0f, 0.0f, 0.0f,
+        0.0f, 1.0f, 1.0f, 1.0f, 0.0f,
+        0.0f, 1.0f, 1.0f, 1.0f, 0.0f,
+        0.0f, 1.0f, 1.0f, 1.0f, 0.0f,
+        0.0f, 0.0f, 0.0f, 0.0f, 0.0f
     };
 
-    // Define 16 surrounding blocks (outer ring)
-    const Vector2i surrounding[16] = {
-        // Top row
-        Vector2i(-2, -2), Vector2i(-1, -2), Vector2i(0, -2), Vector2i(1, -2), Vector2i(2, -2),
-        // Middle rows (left and right)
-        Vector2i(-2, -1), Vector2i(2, -1),
-        Vector2i(-2,  0), Vector2i(2,  0),
-        Vector2i(-2,  1), Vector2i(2,  1),
-        // Bottom row
-        Vector2i(-2,  2), Vector2i(-1,  2), Vector2i(0,  2), Vector2i(1,  2), Vector2i(2,  2)
+    // 16 surrounding blocks (outer ring) take 50% of the APPLIED damage
+    static const float surrounding[25] = {
+        0.5f, 0.5f, 0.5f, 0.5f, 0.5f,
+        0.5f, 0.0f, 0.0f, 0.0f, 0.5f,
+        0.5f, 0.0f, 0.0f, 0.0f, 0.5f,
+        0.5f, 0.0f, 0.0f, 0.0f, 0.5f,
+        0.5f, 0.5f, 0.5f, 0.5f, 0.5f
     };
 
-    // Damage the 3x3 main area with full damage
-    for (const Vector2i& offset : main_area) {
-        Vector2i target_pos = center_pos + offset;
-        DamageResult result = damage_block(target_pos, raw_damage, tool, false);
+    Vector2i mask_origin = center_pos - Vector2i(2, 2);
+
+    // Both passes are one swing: a multi-tile object under both masks is hit once
+    damage_table.refresh(block_registry);
+    pending_multi_tile.clear();
+
+    AreaDamageParams params;
+    params.raw_damage = raw_damage;
+    params.shape = DamageShape::mask(mask_origin, Vector2i(5, 5), main_area);
+    apply_area_pass(params, tool, out_results);
+
+    // Surrounding damage is scaled after reduction (reduction isn't applied twice)
+    // and, like before, ignores the tool tier check
+    params.shape = DamageShape::mask(mask_origin, Vector2i(5, 5), surrounding);
+    params.scale_after_reduction = true;
+    params.respect_tool_tier = false;
+    apply_area_pass(params, tool, out_results);
+}
+
+void BlockDamageSystem::damage_area(const AreaDamageParams& params, const Tool& tool, std::vector<DamageResult>& out_results) {
+    damage_table.refresh(block_registry);
+    pending_multi_tile.clear();
+    apply_area_pass(params, tool, out_results);
+}
+
+void BlockDamageSystem::apply_area_pass(const AreaDamageParams& params, const Tool& tool, std::vector<DamageResult>& out_results) {
+    pending_destruction.clear();
+
+    Rect2i bounds = params.shape.get_tile_bounds();
+    int min_x = bounds.position.x;
+    int max_x = bounds.position.x + bounds.size.x;                 // Exclusive
+    int min_y = std::max(bounds.position.y, 0);
+    int max_y = std::min(bounds.position.y + bounds.size.y, WORLD_HEIGHT);
+    if (min_x >= max_x || min_y >= max_y) {
+        return;
+    }
+
+    // Walk the chunks overlapping the shape, one row span per chunk row
+    Vector2i chunk_min = WorldCoords::tile_to_chunk(Vector2i(min_x, min_y));
+    Vector2i chunk_max = WorldCoords::tile_to_chunk(Vector2i(max_x - 1, max_y - 1));
+
+    for (int cy = chunk_min.y; cy <= chunk_max.y; cy++) {
+        for (int cx = chunk_min.x; cx <= chunk_max.x; cx++) {
+            Chunk2D* chunk = chunk_manager->get_chunk(Vector2i(cx, cy));
+            if (!chunk) {
+                continue; // Not loaded - nothing to damage
+            }
+
+            int chunk_tile_x = WorldGrid::origin_x(cx);
+            int chunk_tile_y = WorldGrid::origin_y(cy);
+            int span_x0 = std::max(min_x, chunk_tile_x);
+            int span_x1 = std::min(max_x, chunk_tile_x + CHUNK_WIDTH);
+            int span_y0 = std::max(min_y, chunk_tile_y);
+            int span_y1 = std::min(max_y, chunk_tile_y + CHUNK_HEIGHT);
+
+            for (int ty = span_y0; ty < span_y1; ty++) {
+                damage_area_row(chunk, params, tool, ty, span_x0, span_x0 - chunk_tile_x, span_x1 - span_x0);
+            }
+        }
+    }
+
+    // Objects spanning several tiles take one hit, however many parts the shape covers
+    resolve_multi_tile_hits();
+
+    // Destroy after the whole shape is damaged so occlusion and falling
+    // neighbors don't depend on iteration order
+    for (DamageResult& result : pending_destruction) {
+        handle_block_destruction(result.destroyed_pos, params.is_background, result);
         if (result.block_destroyed) {
-            results.push_back(result);
+            out_results.push_back(result);
         }
     }
+    pending_destruction.clear();
+}
 
-    // Damage the 16 surrounding blocks with 50% of the APPLIED damage (after reduction)
-    for (const Vector2i& offset : surrounding) {
-        Vector2i target_pos = center_pos + offset;
+void BlockDamageSystem::damage_area_row(Chunk2D* chunk, const AreaDamageParams& params, const Tool& tool,
+                                        int tile_y, int tile_x, int local_x, int count) {
+    // Rows with at least this many damaged survivors use the bulk health update
+    constexpr int BULK_ROW_MIN = 8;
+
+    float weights[CHUNK_WIDTH];
+    float reduction[CHUNK_WIDTH];
+    float max_health[CHUNK_WIDTH];
+    float damageable[CHUNK_WIDTH];
+    float damage[CHUNK_WIDTH];
+    float new_health[CHUNK_WIDTH];
+    uint16_t types[CHUNK_WIDTH];
+    uint16_t quantized[CHUNK_WIDTH];
+
+    const int local_y = WorldGrid::local_y(tile_y);
+
+    params.shape.evaluate_row(tile_y, tile_x, count, params.falloff, weights);
+
+    // Gather per-type properties from the flat tables
+    const ChunkBlockPlane& plane = params.is_background ? chunk->background : chunk->foreground;
+    std::memcpy(types, plane.row_types(local_y) + local_x, count * sizeof(uint16_t));
+    for (int i = 0; i < count; i++) {
+        uint16_t type = types[i];
+        bool known = damage_table.is_known(type);
+        bool tier_ok = known && (!params.respect_tool_tier || tool.tier >= damage_table.required_tool_tier[type]);
+        reduction[i] = known ? damage_table.damage_reduction[type] : 0.0f;
+        max_health[i] = known ? damage_table.max_health[type] : 0.0f;
+        damageable[i] = tier_ok ? 1.0f : 0.0f;
+    }
 
-        const Block2D* block = chunk_manager->get_block_at_tile(target_pos);
-        if (!block || block->type_id == 0) {
-            continue; // No block here
+    // ActualDamage = ToolDamage - BlockDamageReduction, scaled by the shape weight
+    const float raw = params.raw_damage;
+    if (params.scale_after_reduction) {
+        for (int i = 0; i < count; i++) {
+            damage[i] = std::max(0.0f, raw - reduction[i]) * weights[i] * damageable[i];
         }
+    } else {
+        for (int i = 0; i < count; i++) {
+            damage[i] = std::max(0.0f, raw * weights[i] - reduction[i]) * damageable[i];
+        }
+    }
 
-        const BlockDefinition* def = block_registry->get_block_definition(block->type_id);
-        if (!def) {
+    // Resolve health; destroyed blocks are queued, survivors updated below
+    int survivors = 0;
+    for (int i = 0; i < count; i++) {
+        quantized[i] = 0;
+        if (damage[i] <= 0.0f) {
             continue;
         }
 
-        // Calculate actual damage for main hit
-        float actual_main_damage = calculate_actual_damage(raw_damage, def->damage_reduction);
+        Vector2i tile_pos(tile_x + i, tile_y);
+        if (params.occlusion && is_path_occluded(params.shape.get_origin(), tile_pos)) {
+            damage[i] = 0.0f;
+            continue;
+        }
 
-        // Surrounding blocks take 50% of the APPLIED damage
-        float surrounding_damage = actual_main_damage * 0.5f;
+        // Parts of a multi-tile object share the origin's health - merge them
+        // per object and leave only plain tiles on the row path
+        if (chunk_manager->is_multi_tile(types[i])) {
+            Vector2i part = plane.get(local_x + i, local_y).get_part_offset();
+            queue_multi_tile_hit(WorldCoords::wrap_tile_x(tile_pos - part), types[i], damage[i]);
+            damage[i] = 0.0f;
+            continue;
+        }
 
-        // Apply the surrounding damage (no reduction applied again since it's already been reduced)
-        DamageResult result;
-        result.destroyed_pos = target_pos;
+        BlockHealth health;
+        Vector2i local_pos(local_x + i, local_y);
+        float current_health = chunk->get_health(local_pos, health, max_health[i])
+            ? health.current_health : max_health[i];
+        new_health[i] = current_health - damage[i];
+
+        if (new_health[i] <= 0.0f) {
+            DamageResult result;
+            result.destroyed_pos = tile_pos;
+            result.destroyed_block_id = types[i];
+            result.overkill_damage = -new_health[i];
+            pending_destruction.push_back(result);
+            damage[i] = 0.0f;
+        } else {
+            quantized[i] = ChunkHealthStore::quantize_damage(damage[i], max_health[i]);
+            track_regeneration(tile_pos);
+            survivors++;
+        }
+    }
 
-        // Directly apply the surrounding damage
-        if (apply_damage_to_block(target_pos, surrounding_damage, false, result)) {
-            results.push_back(result);
+    if (survivors >= BULK_ROW_MIN) {
+        uint32_t saturated = chunk->block_health.add_row_damage(local_y, local_x, local_x + count, quantized);
 
-            // Damaged blocks near mined blocks can fall even with background support
-            const Block2D* background = chunk_manager->get_block_at_tile(target_pos, true);
-            if (background && background->type_id != 0) {
-                // Has background but still chance to fall if damaged
-                if (def->affected_by_gravity) {
-                    tension_system->queue_stability_check(target_pos);
-                }
+        // Rounding can push a surviving block to zero - store its exact health instead
+        for (int i = 0; i < count && saturated; i++) {
+            if ((saturated >> (local_x + i)) & 1u && damage[i] > 0.0f) {
+                chunk->set_health(Vector2i(local_x + i, local_y), new_health[i], max_health[i]);
+            }
+        }
+    } else if (survivors > 0) {
+        for (int i = 0; i < count; i++) {
+            if (damage[i] > 0.0f) {
+                chunk->set_health(Vector2i(local_x + i, local_y), new_health[i], max_health[i]);
             }
         }
     }
+}
 
-    return results;
+void BlockDamageSystem::queue_multi_tile_hit(Vector2i origin, uint16_t type_id, float damage) {
+    // A shape covers few objects, so a linear search beats hashing here
+    for (MultiTileHit& hit : pending_multi_tile) {
+        if (hit.origin == origin) {
+            // The part with the largest shape weight decides the damage
+            hit.damage = std::max(hit.damage, damage);
+            return;
+        }
+    }
+    pending_multi_tile.emplace_back(origin, type_id, damage);
+}
+
+void BlockDamageSystem::resolve_multi_tile_hits() {
+    for (MultiTileHit& hit : pending_multi_tile) {
+        if (hit.damage <= hit.applied) {
+            continue; // An earlier pass of this call already dealt at least this much
+        }
+        float damage = hit.damage - hit.applied;
+        hit.applied = hit.damage;
+
+        float max_health = damage_table.max_health[hit.type_id];
+        BlockHealth health;
+        float current_health = chunk_manager->get_block_health(hit.origin, health, max_health)
+            ? health.current_health : max_health;
+        current_health -= damage;
+
+        if (current_health <= 0.0f) {
+            DamageResult result;
+            result.destroyed_pos = hit.origin;
+            result.destroyed_block_id = hit.type_id;
+            result.overkill_damage = -current_health;
+            pending_destruction.push_back(result);
+        } else {
+            chunk_manager->set_block_health(hit.origin, current_health, max_health);
+            track_regeneration(hit.origin);
+        }
+    }
+}
+
+bool BlockDamageSystem::is_path_occluded(Vector2i from, Vector2i to) {
+    // Bresenham walk, endpoints excluded
+    int dx = std::abs(to.x - from.x);
+    int dy = -std::abs(to.y - from.y);
+    int step_x = from.x < to.x ? 1 : -1;
+    int step_y = from.y < to.y ? 1 : -1;
+    int err = dx + dy;
+
+    Vector2i pos = from;
+    while (true) {
+        int err2 = 2 * err;
+        if (err2 >= dy) { err += dy; pos.x += step_x; }
+        if (err2 <= dx) { err += dx; pos.y += step_y; }
+        if (pos == to) {
+            return false;
+        }
+
+        BlockView block = chunk_manager->get_block_at_tile(pos);
+        if (block && block->type_id != 0 && !block->has_flag(Block2D::IS_LIQUID)) {
+            return true;
+        }
+    }
 }
 
 float BlockDamageSystem::calculate_actual_damage(float raw_damage, float damage_reduction) const {
@@ -119,20 +321,17 @@ bool BlockDamageSystem::can_mine_block(const Tool& tool, const BlockDefinition*
 }
 
 void BlockDamageSystem::destroy_block(Vector2i tile_pos, bool is_background) {
-    const Block2D* block = chunk_manager->get_block_at_tile(tile_pos, is_background);
+    BlockView block = chunk_manager->get_block_at_tile(tile_pos, is_background);
     if (!block || block->type_id == 0) {
         return; // No block to destroy
     }
 
     uint16_t block_id = block->type_id;
 
-    // Set to air
+    // Set to air (the chunk manager drops the health data when the foreground changes)
     Block2D air;
     air.type_id = 0;
-    chunk_manager->set_block_at_tile(tile_pos, air, is_background);
-
-    // Remove health data
-    chunk_manager->set_block_health(tile_pos, 100.0f, 100.0f);
+    chunk_manager->set_block_at_tile(tile_pos, air, is_background, CAUSE_DESTROYED);
 
     // Spawn item drop
     if (!is_background) {
@@ -144,7 +343,7 @@ void BlockDamageSystem::destroy_block(Vector2i tile_pos, bool is_background) {
 }
 
 void BlockDamageSystem::restore_block_health(Vector2i tile_pos) {
-    const Block2D* block = chunk_manager->get_block_at_tile(tile_pos);
+    BlockView block = chunk_manager->get_block_at_tile(tile_pos);
     if (!block || block->type_id == 0) {
         return;
     }
@@ -163,7 +362,7 @@ bool BlockDamageSystem::apply_damage_to_block(Vector2i tile_pos, float damage, b
         return false; // No damage applied
     }
 
-    const Block2D* block = chunk_manager->get_block_at_tile(tile_pos, is_background);
+    BlockView block = chunk_manager->get_block_at_tile(tile_pos, is_background);
     if (!block || block->type_id == 0) {
         return false;
     }
@@ -174,87 +373,160 @@ bool BlockDamageSystem::apply_damage_to_block(Vector2i tile_pos, float damage, b
     }
 
     // Get current health (default to max if not damaged yet)
-    BlockHealth* health = chunk_manager->get_block_health(tile_pos);
-    float current_health = health ? health->current_health : def->max_health;
+    BlockHealth health;
+    float current_health = chunk_manager->get_block_health(tile_pos, health, def->max_health)
+        ? health.current_health : def->max_health;
 
     // Apply damage
     current_health -= damage;
 
+    // Regeneration is tracked by wrapped position so both sides of the seam share an entry
+    Vector2i wrapped_pos = WorldCoords::wrap_tile_x(tile_pos);
+
     // Check if block is destroyed
     if (current_health <= 0.0f) {
         result.overkill_damage = -current_health; // How much extra damage was dealt
         handle_block_destruction(tile_pos, is_background, result);
-        // Remove from regeneration tracker
-        regeneration_tracker.erase(tile_pos);
+        // Remove from regeneration tracker (queued event becomes stale)
+        regeneration_tracker.erase(wrapped_pos);
         return true;
     } else {
         // Update health
         chunk_manager->set_block_health(tile_pos, current_health, def->max_health);
 
         // Track for regeneration
-        BlockRegeneration& regen = regeneration_tracker[tile_pos];
-        regen.last_damage_time = current_time;
-        regen.next_regen_time = current_time + 2.0f; // 2 second delay before regen starts
+        track_regeneration(wrapped_pos);
 
         return false;
     }
 }
 
+void BlockDamageSystem::track_regeneration(Vector2i tile_pos) {
+    Vector2i wrapped_pos = WorldCoords::wrap_tile_x(tile_pos);
+    BlockRegeneration& regen = regeneration_tracker[wrapped_pos];
+    regen.last_damage_time = current_time;
+    regen.next_regen_time = current_time + REGEN_START_DELAY; // 2 second delay before regen starts
+    schedule_regeneration(wrapped_pos, regen.next_regen_time);
+}
+
 void BlockDamageSystem::update_regeneration(float delta_time) {
     current_time += delta_time;
 
-    std::vector<Vector2i> to_remove;
+    // Pop every event that is due this frame
+    due_regenerations.clear();
+    while (!regeneration_queue.empty() && regeneration_queue.front().due_time <= current_time) {
+        std::pop_heap(regeneration_queue.begin(), regeneration_queue.end());
+        const RegenerationEvent& event = regeneration_queue.back();
 
-    for (auto& [pos, regen] : regeneration_tracker) {
-        // Check if 2 second delay has passed
-        if (current_time < regen.next_regen_time) {
-            continue; // Still waiting
+        // Skip stale events (block re-damaged, destroyed or already healed)
+        auto it = regeneration_tracker.find(event.tile_pos);
+        if (it != regeneration_tracker.end() && it->second.next_regen_time == event.due_time) {
+            due_regenerations.push_back(event);
         }
+        regeneration_queue.pop_back();
+    }
 
-        // Regenerate 35 health per 0.5 seconds
-        const Block2D* block = chunk_manager->get_block_at_tile(pos);
+    if (due_regenerations.empty()) {
+        return;
+    }
+
+    // Group by chunk so each chunk is looked up once per frame
+    std::sort(due_regenerations.begin(), due_regenerations.end(),
+        [](const RegenerationEvent& a, const RegenerationEvent& b) {
+            Vector2i chunk_a = WorldCoords::tile_to_chunk(a.tile_pos);
+            Vector2i chunk_b = WorldCoords::tile_to_chunk(b.tile_pos);
+            if (chunk_a.x != chunk_b.x) return chunk_a.x < chunk_b.x;
+            return chunk_a.y < chunk_b.y;
+        });
+
+    size_t batch_start = 0;
+    while (batch_start < due_regenerations.size()) {
+        Vector2i chunk_pos = WorldCoords::tile_to_chunk(due_regenerations[batch_start].tile_pos);
+        size_t batch_end = batch_start + 1;
+        while (batch_end < due_regenerations.size() &&
+               WorldCoords::tile_to_chunk(due_regenerations[batch_end].tile_pos) == chunk_pos) {
+            batch_end++;
+        }
+
+        regenerate_chunk_batch(chunk_manager->get_chunk(chunk_pos),
+                               &due_regenerations[batch_start], batch_end - batch_start);
+        batch_start = batch_end;
+    }
+
+    compact_regeneration_queue();
+}
+
+void BlockDamageSystem::regenerate_chunk_batch(Chunk2D* chunk, const RegenerationEvent* events, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        const Vector2i& pos = events[i].tile_pos;
+
+        // Chunk unloaded - nothing left to regenerate
+        if (!chunk) {
+            regeneration_tracker.erase(pos);
+            continue;
+        }
+
+        Vector2i local_pos = WorldCoords::tile_to_local(pos);
+        BlockView block = chunk->get_block(local_pos);
         if (!block || block->type_id == 0) {
-            to_remove.push_back(pos);
+            regeneration_tracker.erase(pos);
             continue;
         }
 
         const BlockDefinition* def = block_registry->get_block_definition(block->type_id);
         if (!def) {
-            to_remove.push_back(pos);
+            regeneration_tracker.erase(pos);
             continue;
         }
 
         // Get current health
-        BlockHealth* health = chunk_manager->get_block_health(pos);
-        if (!health) {
+        BlockHealth health;
+        if (!chunk->get_health(local_pos, health, def->max_health)) {
             // Fully healed already
-            to_remove.push_back(pos);
+            regeneration_tracker.erase(pos);
             continue;
         }
 
-        // Regenerate health
-        float new_health = health->current_health + 35.0f;
+        // Regenerate 35 health per 0.5 seconds
+        float new_health = health.current_health + REGEN_AMOUNT_PER_TICK;
+        chunk_manager->get_block_events().push(pos, block->type_id, block->type_id, CAUSE_REGENERATED, false);
 
         if (new_health >= def->max_health) {
             // Fully healed
-            chunk_manager->set_block_health(pos, def->max_health, def->max_health);
-            to_remove.push_back(pos);
+            chunk->set_health(local_pos, def->max_health, def->max_health);
+            regeneration_tracker.erase(pos);
         } else {
             // Partially healed
-            chunk_manager->set_block_health(pos, new_health, def->max_health);
+            chunk->set_health(local_pos, new_health, def->max_health);
             // Schedule next regen tick in 0.5 seconds
-            regen.next_regen_time = current_time + 0.5f;
+            BlockRegeneration& regen = regeneration_tracker[pos];
+            regen.next_regen_time = current_time + REGEN_TICK_INTERVAL;
+            schedule_regeneration(pos, regen.next_regen_time);
         }
     }
+}
+
+void BlockDamageSystem::schedule_regeneration(Vector2i tile_pos, float due_time) {
+    regeneration_queue.push_back(RegenerationEvent(due_time, tile_pos));
+    std::push_heap(regeneration_queue.begin(), regeneration_queue.end());
+}
+
+void BlockDamageSystem::compact_regeneration_queue() {
+    // Repeated hits on the same block leave stale events behind
+    // Rebuild once they outnumber live entries 4:1
+    if (regeneration_queue.size() < 1024 || regeneration_queue.size() < regeneration_tracker.size() * 4) {
+        return;
+    }
 
-    // Remove fully healed blocks from tracker
-    for (const auto& pos : to_remove) {
-        regeneration_tracker.erase(pos);
+    regeneration_queue.clear();
+    for (const auto& [pos, regen] : regeneration_tracker) {
+        regeneration_queue.push_back(RegenerationEvent(regen.next_regen_time, pos));
     }
+    std::make_heap(regeneration_queue.begin(), regeneration_queue.end());
 }
 
 void BlockDamageSystem::handle_block_destruction(Vector2i tile_pos, bool is_background, DamageResult& result) {
-    const Block2D* block = chunk_manager->get_block_at_tile(tile_pos, is_background);
+    BlockView block = chunk_manager->get_block_at_tile(tile_pos, is_background);
     if (!block || block->type_id == 0) {
         return;
     }
@@ -268,11 +540,9 @@ void BlockDamageSystem::handle_block_destruction(Vector2i tile_pos, bool is_back
 }
 
 void BlockDamageSystem::spawn_item_drop(Vector2i tile_pos, uint16_t block_id) {
-    // TODO: Integrate with item system
-    // For now, just placeholder
-    // Vector2 world_pos = WorldCoords::tile_to_world(tile_pos);
-    // ItemDrop item;
-    // item.item_id = block_id;
-    // item.position = world_pos;
-    // item_system->spawn_item(item);
+    if (!item_drops) {
+        return;
+    }
+
+    item_drops->spawn_at_tile(tile_pos, block_id);
 }
@@ -5,6 +5,8 @@
 #include "chunk_manager.h"
 #include "block_registry.h"
 #include "block_tension.h"
+#include "area_damage.h"
+#include "item_drops.h"
 #include <godot_cpp/variant/vector2i.hpp>
 #include <godot_cpp/variant/rect2i.hpp>
 #include <vector>
@@ -40,21 +42,73 @@ struct BlockRegeneration {
     BlockRegeneration() : last_damage_time(0.0f), next_regen_time(0.0f) {}
 };
 
+// Entry in the regeneration min-heap (ordered by due time)
+// Entries are never removed early: when a block is damaged again a new entry
+// is pushed and the old one is discarded once it reaches the top, because its
+// due time no longer matches the tracker.
+struct RegenerationEvent {
+    float due_time;             // Copy of next_regen_time when scheduled
+    Vector2i tile_pos;          // Wrapped tile position
+
+    RegenerationEvent() : due_time(0.0f) {}
+    RegenerationEvent(float time, Vector2i pos) : due_time(time), tile_pos(pos) {}
+
+    // Inverted so std heap algorithms keep the earliest event on top
+    bool operator<(const RegenerationEvent& other) const { return due_time > other.due_time; }
+};
+
+// A multi-tile object hit by an area pass, merged over all of its parts
+struct MultiTileHit {
+    Vector2i origin;            // Wrapped origin tile (holds the object's health)
+    uint16_t type_id;
+    float damage;               // Largest damage any single part took
+    float applied;              // Part of it already dealt by an earlier pass
+
+    MultiTileHit() : type_id(0), damage(0.0f), applied(0.0f) {}
+    MultiTileHit(Vector2i pos, uint16_t type, float amount)
+        : origin(pos), type_id(type), damage(amount), applied(0.0f) {}
+};
+
+// Regeneration timing (seconds / health points)
+constexpr float REGEN_START_DELAY = 2.0f;      // Delay after last damage
+constexpr float REGEN_TICK_INTERVAL = 0.5f;    // Time between regen ticks
+constexpr float REGEN_AMOUNT_PER_TICK = 35.0f; // Health restored per tick
+
 class BlockDamageSystem {
 private:
     ChunkManager* chunk_manager;
     BlockRegistry* block_registry;
     BlockTensionSystem* tension_system;
+    ItemDropSystem* item_drops;         // Optional, receives mined blocks
 
     // Track damaged blocks for regeneration
-    std::unordered_map<Vector2i, BlockRegeneration, Vector2iHash> regeneration_tracker;
+    FlatHashMap<Vector2i, BlockRegeneration, Vector2iHash> regeneration_tracker;
     float current_time;  // Track game time
 
+    // Pending regeneration ticks, min-heap on due time
+    // Only blocks that are due get touched each frame
+    std::vector<RegenerationEvent> regeneration_queue;
+
+    // Scratch buffer for due events (reused every frame)
+    std::vector<RegenerationEvent> due_regenerations;
+
+    // Flat per-type damage properties for the area kernel
+    BlockDamageTable damage_table;
+
+    // Blocks destroyed by the current area pass (destroyed after damage is applied)
+    std::vector<DamageResult> pending_destruction;
+
+    // Multi-tile objects hit by the current area damage call, one entry per origin
+    // (kept across both passes of a 3x3 swing so an object is hit once per swing)
+    std::vector<MultiTileHit> pending_multi_tile;
+
 public:
-    BlockDamageSystem(ChunkManager* chunks, BlockRegistry* registry, BlockTensionSystem* tension)
+    BlockDamageSystem(ChunkManager* chunks, BlockRegistry* registry, BlockTensionSystem* tension,
+                      ItemDropSystem* drops = nullptr)
         : chunk_manager(chunks)
         , block_registry(registry)
         , tension_system(tension)
+        , item_drops(drops)
         , current_time(0.0f)
     {}
 
@@ -65,6 +119,12 @@ public:
     // Damage blocks in a 3x3 area (for player cursor)
     // Also damages the 16 surrounding blocks with 50% of applied damage
     std::vector<DamageResult> damage_3x3_area(Vector2i center_pos, float raw_damage, const Tool& tool);
+    void damage_3x3_area(Vector2i center_pos, float raw_damage, const Tool& tool, std::vector<DamageResult>& out_results);
+
+    // Damage every block covered by a shape (explosions, drills, lasers)
+    // Tiles are processed row by row per chunk; all blocks are damaged before any is destroyed
+    // Destroyed blocks are appended to out_results (caller owns and reuses the buffer)
+    void damage_area(const AreaDamageParams& params, const Tool& tool, std::vector<DamageResult>& out_results);
 
     // Calculate actual damage after reduction
     float calculate_actual_damage(float raw_damage, float damage_reduction) const;
@@ -80,8 +140,15 @@ public:
 
     // Update regeneration system (call every frame)
     // Regenerates blocks after 2 seconds: 35 health per 0.5 seconds
+    // Cost is proportional to the number of blocks due this frame
     void update_regeneration(float delta_time);
 
+    // Get number of blocks waiting to regenerate
+    size_t get_regenerating_block_count() const { return regeneration_tracker.size(); }
+
+    // Probe lengths of the regeneration table
+    FlatHashMapStats get_regeneration_map_stats() const { return regeneration_tracker.get_stats(); }
+
 private:
     // Apply damage and check if block should be destroyed
     bool apply_damage_to_block(Vector2i tile_pos, float damage, bool is_background, DamageResult& result);
@@ -89,6 +156,34 @@ private:
     // Handle block destruction
     void handle_block_destruction(Vector2i tile_pos, bool is_background, DamageResult& result);
 
+    // Start (or restart) the regeneration delay for a damaged block
+    void track_regeneration(Vector2i tile_pos);
+
+    // Check if solid foreground blocks lie strictly between two tiles
+    bool is_path_occluded(Vector2i from, Vector2i to);
+
+    // One shape pass of damage_area, merging multi-tile hits into pending_multi_tile
+    void apply_area_pass(const AreaDamageParams& params, const Tool& tool, std::vector<DamageResult>& out_results);
+
+    // Apply one row of area damage inside a chunk
+    void damage_area_row(Chunk2D* chunk, const AreaDamageParams& params, const Tool& tool,
+                         int tile_y, int tile_x, int local_x, int count);
+
+    // Record an area hit on one part of a multi-tile object
+    void queue_multi_tile_hit(Vector2i origin, uint16_t type_id, float damage);
+
+    // Deal each object in pending_multi_tile its damage not yet applied, through its origin
+    void resolve_multi_tile_hits();
+
+    // Schedule a regeneration tick for a (wrapped) tile position
+    void schedule_regeneration(Vector2i tile_pos, float due_time);
+
+    // Rebuild the heap without stale entries once they dominate it
+    void compact_regeneration_queue();
+
+    // Regenerate all due blocks that live in one chunk
+    void regenerate_chunk_batch(Chunk2D* chunk, const RegenerationEvent* events, size_t count);
+
     // Spawn item drop when block is destroyed
     void spawn_item_drop(Vector2i tile_pos, uint16_t block_id);
 };
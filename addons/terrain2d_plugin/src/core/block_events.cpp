@@ -0,0 +1,31 @@
+#include "block_events.h"
+
+using namespace godot;
+
+BlockEventStream::BlockEventStream() : enabled(true) {
+    recording.reserve(DEFAULT_CAPACITY);
+    published.reserve(DEFAULT_CAPACITY);
+}
+
+void BlockEventStream::publish_frame() {
+    published.swap(recording);
+    recording.clear();
+}
+
+void BlockEventStream::pack_frame(PackedInt32Array& out) const {
+    out.resize(static_cast<int64_t>(published.size()) * PACKED_STRIDE);
+    int32_t* dst = out.ptrw();
+
+    for (const BlockChangeEvent& event : published) {
+        dst[0] = event.tile_x;
+        dst[1] = event.tile_y;
+        dst[2] = static_cast<int32_t>((static_cast<uint32_t>(event.old_type) << 16) | event.new_type);
+        dst[3] = static_cast<int32_t>(event.cause | (event.is_background << 8));
+        dst += PACKED_STRIDE;
+    }
+}
+
+void BlockEventStream::clear() {
+    recording.clear();
+    published.clear();
+}
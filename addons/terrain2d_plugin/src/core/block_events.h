@@ -0,0 +1,93 @@
+#ifndef BLOCK_EVENTS_H
+#define BLOCK_EVENTS_H
+
+#include "../world/block_data.h"
+#include <godot_cpp/variant/vector2i.hpp>
+#include <godot_cpp/variant/packed_int32_array.hpp>
+#include <vector>
+#include <cstdint>
+
+using namespace godot;
+
+// Why a tile changed
+enum BlockChangeCause : uint8_t {
+    CAUSE_PLACED = 0,       // Placed by gameplay/scripts
+    CAUSE_DESTROYED,        // Mined or blown up
+    CAUSE_FELL,             // Lost support and became a falling block
+    CAUSE_LANDED,           // Falling block settled into the grid
+    CAUSE_REGENERATED,      // Health restored (type unchanged)
+    CAUSE_REACTED,          // Formed by a liquid reaction (lava + water -> obsidian)
+    CAUSE_COUNT
+};
+
+// Compact record of one tile change (16 bytes)
+struct BlockChangeEvent {
+    int32_t tile_x;             // Wrapped tile X
+    int32_t tile_y;             // Tile Y
+    uint16_t old_type;          // Type before the change
+    uint16_t new_type;          // Type after the change
+    uint8_t cause;              // BlockChangeCause
+    uint8_t is_background;      // 1 = background layer
+    uint16_t reserved;
+
+    inline Vector2i get_tile_pos() const { return Vector2i(tile_x, tile_y); }
+};
+
+// Per-frame stream of block changes
+// Systems record changes while the frame runs; publish_frame() then hands the
+// whole frame to consumers at once (meshing, lighting, networking, scripts).
+// Two preallocated buffers are swapped each frame, so publishing never copies
+// and recording never allocates once the buffers have grown to the peak load.
+class BlockEventStream {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 4096;
+
+    // Ints per event in the packed script format
+    static constexpr int PACKED_STRIDE = 4;
+
+    BlockEventStream();
+
+    // Record a change (ignored while disabled)
+    inline void push(Vector2i tile_pos, uint16_t old_type, uint16_t new_type, BlockChangeCause cause, bool is_background) {
+        if (!enabled) {
+            return;
+        }
+        BlockChangeEvent event;
+        event.tile_x = tile_pos.x;
+        event.tile_y = tile_pos.y;
+        event.old_type = old_type;
+        event.new_type = new_type;
+        event.cause = cause;
+        event.is_background = is_background ? 1 : 0;
+        event.reserved = 0;
+        recording.push_back(event);
+    }
+
+    // End the frame: everything recorded since the last call becomes the published frame
+    void publish_frame();
+
+    // Published frame (valid until the next publish_frame)
+    const BlockChangeEvent* get_frame_events() const { return published.data(); }
+    size_t get_frame_event_count() const { return published.size(); }
+
+    // Events recorded so far in the current (unpublished) frame
+    size_t get_pending_event_count() const { return recording.size(); }
+
+    // Pack the published frame for GDScript, PACKED_STRIDE ints per event:
+    // [tile_x, tile_y, (old_type << 16) | new_type, cause | (is_background << 8)]
+    void pack_frame(PackedInt32Array& out) const;
+
+    // Disable during bulk edits nobody needs to hear about (world generation)
+    void set_enabled(bool value) { enabled = value; }
+    bool is_enabled() const { return enabled; }
+
+    // Drop everything (both buffers keep their capacity)
+    void clear();
+
+private:
+    std::vector<BlockChangeEvent> recording;
+    std::vector<BlockChangeEvent> published;
+    bool enabled;
+};
+
+#endif // BLOCK_EVENTS_H
@@ -1,5 +1,6 @@
 #include "block_registry.h"
 #include <godot_cpp/core/class_db.hpp>
+#include <algorithm>
 
 using namespace godot;
 
@@ -35,12 +36,21 @@ void BlockResource::_bind_methods() {
     ClassDB::bind_method(D_METHOD("set_light_emission", "emission"), &BlockResource::set_light_emission);
     ClassDB::bind_method(D_METHOD("get_light_emission"), &BlockResource::get_light_emission);
 
+    ClassDB::bind_method(D_METHOD("set_is_solid", "value"), &BlockResource::set_is_solid);
+    ClassDB::bind_method(D_METHOD("get_is_solid"), &BlockResource::get_is_solid);
+
+    ClassDB::bind_method(D_METHOD("set_is_platform", "value"), &BlockResource::set_is_platform);
+    ClassDB::bind_method(D_METHOD("get_is_platform"), &BlockResource::get_is_platform);
+
     ClassDB::bind_method(D_METHOD("set_is_ore", "value"), &BlockResource::set_is_ore);
     ClassDB::bind_method(D_METHOD("get_is_ore"), &BlockResource::get_is_ore);
 
     ClassDB::bind_method(D_METHOD("set_can_be_background", "value"), &BlockResource::set_can_be_background);
     ClassDB::bind_method(D_METHOD("get_can_be_background"), &BlockResource::get_can_be_background);
 
+    ClassDB::bind_method(D_METHOD("set_size", "size"), &BlockResource::set_size);
+    ClassDB::bind_method(D_METHOD("get_size"), &BlockResource::get_size);
+
     ADD_PROPERTY(PropertyInfo(Variant::INT, "block_id"), "set_block_id", "get_block_id");
     ADD_PROPERTY(PropertyInfo(Variant::STRING, "block_name"), "set_block_name", "get_block_name");
     ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "max_health"), "set_max_health", "get_max_health");
@@ -49,8 +59,11 @@ void BlockResource::_bind_methods() {
     ADD_PROPERTY(PropertyInfo(Variant::BOOL, "affected_by_gravity"), "set_affected_by_gravity", "get_affected_by_gravity");
     ADD_PROPERTY(PropertyInfo(Variant::INT, "light_opacity"), "set_light_opacity", "get_light_opacity");
     ADD_PROPERTY(PropertyInfo(Variant::INT, "light_emission"), "set_light_emission", "get_light_emission");
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "is_solid"), "set_is_solid", "get_is_solid");
+    ADD_PROPERTY(PropertyInfo(Variant::BOOL, "is_platform"), "set_is_platform", "get_is_platform");
     ADD_PROPERTY(PropertyInfo(Variant::BOOL, "is_ore"), "set_is_ore", "get_is_ore");
     ADD_PROPERTY(PropertyInfo(Variant::BOOL, "can_be_background"), "set_can_be_background", "get_can_be_background");
+    ADD_PROPERTY(PropertyInfo(Variant::VECTOR2I, "size"), "set_size", "get_size");
 }
 
 // BlockRegistry implementation
@@ -58,6 +71,12 @@ BlockRegistry::BlockRegistry() {
     singleton = this;
 }
 
+BlockRegistry::~BlockRegistry() {
+    if (singleton == this) {
+        singleton = nullptr;
+    }
+}
+
 BlockRegistry* BlockRegistry::get_singleton() {
     return singleton;
 }
@@ -65,6 +84,7 @@ BlockRegistry* BlockRegistry::get_singleton() {
 void BlockRegistry::register_block(const BlockDefinition& def) {
     blocks[def.id] = def;
     name_to_id[def.name] = def.id;
+    version++;
 }
 
 void BlockRegistry::register_block_resource(Ref<BlockResource> resource) {
@@ -93,10 +113,19 @@ bool BlockRegistry::has_block(uint16_t id) const {
     return blocks.find(id) != blocks.end();
 }
 
+uint16_t BlockRegistry::get_max_block_id() const {
+    uint16_t max_id = 0;
+    for (const auto& [id, def] : blocks) {
+        max_id = std::max(max_id, id);
+    }
+    return max_id;
+}
+
 void BlockRegistry::clear() {
     blocks.clear();
     name_to_id.clear();
     next_id = 1;
+    version++;
 }
 
 void BlockRegistry::initialize_default_blocks() {
@@ -217,6 +246,7 @@ void BlockRegistry::initialize_default_blocks() {
     torch.light_color = Color(1.0, 0.9, 0.7);  // Warm light
     torch.size = Vector2i(1, 1);
     torch.breaks_on_fall = true;
+    torch.is_solid = false;
     register_block(torch);
 
     // CAVE STONE (ID 10) - inside caves, drops regular stone
@@ -251,4 +281,16 @@ void BlockRegistry::initialize_default_blocks() {
     mossy_cave_stone.light_opacity = 255;
     mossy_cave_stone.use_autotile = true;
     register_block(mossy_cave_stone);
+
+    // OBSIDIAN (ID 13) - formed where lava meets water, acid can't dissolve it
+    BlockDefinition obsidian;
+    obsidian.id = 13;
+    obsidian.name = "obsidian";
+    obsidian.max_health = 300;
+    obsidian.damage_reduction = 90;
+    obsidian.required_tool_tier = 4;
+    obsidian.light_opacity = 255;
+    obsidian.use_autotile = true;
+    obsidian.can_be_background = true;
+    register_block(obsidian);
 }
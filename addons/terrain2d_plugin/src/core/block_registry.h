@@ -48,12 +48,22 @@ public:
     void set_light_emission(int emission) { definition.light_emission = static_cast<uint8_t>(emission); }
     int get_light_emission() const { return definition.light_emission; }
 
+    void set_is_solid(bool value) { definition.is_solid = value; }
+    bool get_is_solid() const { return definition.is_solid; }
+
+    void set_is_platform(bool value) { definition.is_platform = value; }
+    bool get_is_platform() const { return definition.is_platform; }
+
     void set_is_ore(bool value) { definition.is_ore = value; }
     bool get_is_ore() const { return definition.is_ore; }
 
     void set_can_be_background(bool value) { definition.can_be_background = value; }
     bool get_can_be_background() const { return definition.can_be_background; }
 
+    // Tiles covered (doors, chests), up to Block2D::MAX_PART_SIZE per axis
+    void set_size(Vector2i size) { definition.size = size; }
+    Vector2i get_size() const { return definition.size; }
+
     // Get the full definition
     const BlockDefinition& get_definition() const { return definition; }
     BlockDefinition& get_definition_mut() { return definition; }
@@ -73,9 +83,12 @@ private:
     // Next auto-assigned ID
     uint16_t next_id = 1; // 0 is reserved for AIR
 
+    // Bumped whenever definitions change (lets systems cache flat per-type tables)
+    uint32_t version = 0;
+
 public:
     BlockRegistry();
-    ~BlockRegistry() = default;
+    ~BlockRegistry();
 
     static BlockRegistry* get_singleton();
 
@@ -94,6 +107,12 @@ public:
     // Check if block ID exists
     bool has_block(uint16_t id) const;
 
+    // Highest registered block ID (size flat per-type tables with this + 1)
+    uint16_t get_max_block_id() const;
+
+    // Definition change counter
+    uint32_t get_version() const { return version; }
+
     // Get all registered blocks
     const std::unordered_map<uint16_t, BlockDefinition>& get_all_blocks() const {
         return blocks;
@@ -10,31 +10,35 @@ void BlockTensionSystem::update(float delta_time) {
         FallingBlock& fb = *it;
 
         // Apply gravity
-        fb.velocity.y += GRAVITY * delta_time;
+        fb.velocity.y += GRAVITY * DOWN_Y * delta_time;
 
         // Clamp to terminal velocity
-        if (fb.velocity.y > MAX_FALL_SPEED) {
-            fb.velocity.y = MAX_FALL_SPEED;
+        if (fb.velocity.y * DOWN_Y > MAX_FALL_SPEED) {
+            fb.velocity.y = MAX_FALL_SPEED * DOWN_Y;
         }
 
-        // Move block
-        fb.position += fb.velocity * delta_time;
-
-        // Check if block hit ground or went out of bounds
-        Vector2i tile_pos = WorldCoords::world_to_tile(fb.position);
+        // Move the block's tile-sized box through the grid, sliding along walls
+        const Vector2 half_tile(TILE_SIZE_PIXELS * 0.5f, TILE_SIZE_PIXELS * 0.5f);
+        TileSlideResult slide = chunk_manager->move_and_slide_tiles(
+            Rect2(fb.position - half_tile, half_tile * 2.0f), fb.velocity * delta_time);
+        fb.position += slide.travel;
+        if (slide.on_wall) {
+            fb.velocity.x = 0.0f;
+        }
+        if (slide.on_ceiling) {
+            fb.velocity.y = 0.0f;
+        }
 
         // Check if out of world bounds
+        Vector2i tile_pos = WorldCoords::world_to_tile(fb.position);
         if (!WorldCoords::is_valid_y(tile_pos.y)) {
             // Block fell out of world - remove it
             it = falling_blocks.erase(it);
             continue;
         }
 
-        // Check if hit solid block below
-        Vector2i below_pos = Vector2i(tile_pos.x, tile_pos.y + 1);
-        const Block2D* below = chunk_manager->get_block_at_tile(below_pos);
-
-        if (below && below->type_id != 0) { // 0 = air
+        // Landed on a solid block or platform
+        if (slide.on_floor) {
             // Hit something - try to place block
             if (try_place_falling_block(fb)) {
                 // Successfully placed
@@ -52,12 +56,12 @@ void BlockTensionSystem::update(float delta_time) {
 }
 
 bool BlockTensionSystem::is_block_stable(Vector2i tile_pos) {
-    const Block2D* block = chunk_manager->get_block_at_tile(tile_pos);
-    if (!block || block->type_id == 0) {
+    const uint16_t type_id = chunk_manager->get_block_type_at_tile(tile_pos);
+    if (type_id == 0) {
         return true; // Air is always stable
     }
 
-    const BlockDefinition* def = block_registry->get_block_definition(block->type_id);
+    const BlockDefinition* def = block_registry->get_block_definition(type_id);
     if (!def) {
         return true; // Unknown block, assume stable
     }
@@ -111,7 +115,7 @@ void BlockTensionSystem::check_neighbors_after_mining(Vector2i mined_pos) {
 
     for (const Vector2i& offset : cardinals) {
         Vector2i neighbor_pos = mined_pos + offset;
-        const Block2D* neighbor = chunk_manager->get_block_at_tile(neighbor_pos);
+        BlockView neighbor = chunk_manager->get_block_at_tile(neighbor_pos);
 
         if (!neighbor || neighbor->type_id == 0) {
             continue; // No block here
@@ -124,8 +128,7 @@ void BlockTensionSystem::check_neighbors_after_mining(Vector2i mined_pos) {
 
         // Cardinal neighbors have a chance to fall even with background support
         // Check if neighbor has background support
-        const Block2D* background = chunk_manager->get_block_at_tile(neighbor_pos, true);
-        bool has_background = (background && background->type_id != 0);
+        bool has_background = chunk_manager->get_block_type_at_tile(neighbor_pos, true) != 0;
 
         if (has_background) {
             // 30% chance to fall anyway if directly next to mined block
@@ -160,7 +163,7 @@ void BlockTensionSystem::check_neighbors_after_mining(Vector2i mined_pos) {
 }
 
 void BlockTensionSystem::make_block_fall(Vector2i tile_pos) {
-    const Block2D* block = chunk_manager->get_block_at_tile(tile_pos);
+    BlockView block = chunk_manager->get_block_at_tile(tile_pos);
     if (!block || block->type_id == 0) {
         return; // No block to fall
     }
@@ -178,7 +181,7 @@ void BlockTensionSystem::make_block_fall(Vector2i tile_pos) {
     // Remove block from world
     Block2D air;
     air.type_id = 0;
-    chunk_manager->set_block_at_tile(tile_pos, air);
+    chunk_manager->set_block_at_tile(tile_pos, air, false, CAUSE_FELL);
 
     // Queue neighbors for stability check
     for (int dx = -1; dx <= 1; dx++) {
@@ -190,9 +193,17 @@ void BlockTensionSystem::make_block_fall(Vector2i tile_pos) {
 }
 
 int BlockTensionSystem::count_solid_neighbors(Vector2i tile_pos, bool& has_background_support) {
+    // One chunk lookup, tiles across its edges come through the neighbor pointers
+    tile_pos = WorldCoords::wrap_tile_x(tile_pos);
+    const Chunk2D* chunk = static_cast<const ChunkManager*>(chunk_manager)->get_chunk(WorldCoords::tile_to_chunk(tile_pos));
+    if (!chunk) {
+        has_background_support = false;
+        return 0;
+    }
+    const Vector2i local = WorldCoords::tile_to_local(tile_pos);
+
     // Check background first
-    const Block2D* background = chunk_manager->get_block_at_tile(tile_pos, true);
-    has_background_support = (background && background->type_id != 0);
+    has_background_support = chunk->background.get_type(local.x, local.y) != 0;
 
     // Count solid neighbors (8 directions)
     int solid_count = 0;
@@ -203,8 +214,7 @@ int BlockTensionSystem::count_solid_neighbors(Vector2i tile_pos, bool& has_backg
     };
 
     for (const Vector2i& offset : offsets) {
-        Vector2i neighbor_pos = tile_pos + offset;
-        if (is_solid_block(neighbor_pos)) {
+        if (is_solid_block(chunk->get_block_around(local.x + offset.x, local.y + offset.y).get())) {
             solid_count++;
         }
     }
@@ -212,8 +222,7 @@ int BlockTensionSystem::count_solid_neighbors(Vector2i tile_pos, bool& has_backg
     return solid_count;
 }
 
-bool BlockTensionSystem::is_solid_block(Vector2i tile_pos) {
-    const Block2D* block = chunk_manager->get_block_at_tile(tile_pos);
+bool BlockTensionSystem::is_solid_block(const Block2D* block) {
     if (!block || block->type_id == 0) {
         return false; // Air is not solid
     }
@@ -258,8 +267,7 @@ bool BlockTensionSystem::try_place_falling_block(const FallingBlock& fb) {
     Vector2i tile_pos = WorldCoords::world_to_tile(fb.position);
 
     // Check if position is empty
-    const Block2D* existing = chunk_manager->get_block_at_tile(tile_pos);
-    if (existing && existing->type_id != 0) {
+    if (chunk_manager->get_block_type_at_tile(tile_pos) != 0) {
         return false; // Position occupied
     }
 
@@ -275,14 +283,16 @@ bool BlockTensionSystem::try_place_falling_block(const FallingBlock& fb) {
     }
 
     // Place block
-    chunk_manager->set_block_at_tile(tile_pos, fb.block_data);
+    chunk_manager->set_block_at_tile(tile_pos, fb.block_data, false, CAUSE_LANDED);
 
     return true;
 }
 
 void BlockTensionSystem::spawn_item_drop(const FallingBlock& fb) {
-    // TODO: Integrate with item drop system
-    // For now, just print debug message
-    Vector2i tile_pos = WorldCoords::world_to_tile(fb.position);
-    // UtilityFunctions::print("Block ", fb.block_id, " broke at ", tile_pos);
+    if (!item_drops) {
+        return;
+    }
+
+    // Keep the falling block's horizontal motion
+    item_drops->spawn(fb.position, fb.block_id, 1, Vector2(fb.velocity.x, 0.0f));
 }
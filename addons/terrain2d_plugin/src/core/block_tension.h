@@ -5,6 +5,7 @@
 #include "../world/world_constants.h"
 #include "chunk_manager.h"
 #include "block_registry.h"
+#include "item_drops.h"
 #include <godot_cpp/variant/vector2i.hpp>
 #include <godot_cpp/variant/vector2.hpp>
 #include <vector>
@@ -31,6 +32,7 @@ class BlockTensionSystem {
 private:
     ChunkManager* chunk_manager;
     BlockRegistry* block_registry;
+    ItemDropSystem* item_drops;      // Optional, receives blocks that break on landing
 
     // Active falling blocks
     std::vector<FallingBlock> falling_blocks;
@@ -39,9 +41,10 @@ private:
     std::vector<Vector2i> stability_check_queue;
 
 public:
-    BlockTensionSystem(ChunkManager* chunks, BlockRegistry* registry)
+    BlockTensionSystem(ChunkManager* chunks, BlockRegistry* registry, ItemDropSystem* drops = nullptr)
         : chunk_manager(chunks)
         , block_registry(registry)
+        , item_drops(drops)
     {}
 
     // Update physics for falling blocks
@@ -73,8 +76,8 @@ private:
     // Count solid neighbors (including background)
     int count_solid_neighbors(Vector2i tile_pos, bool& has_background_support);
 
-    // Check if block at position is solid
-    bool is_solid_block(Vector2i tile_pos);
+    // Check if a block is solid (nullptr = not loaded, not solid)
+    bool is_solid_block(const Block2D* block);
 
     // Check if block can provide support
     bool can_support(const Block2D* block, const BlockDefinition* def);
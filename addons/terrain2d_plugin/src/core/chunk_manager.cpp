@@ -1,13 +1,37 @@
 #include "chunk_manager.h"
+#include "block_registry.h"
 #include <algorithm>
+#include <cmath>
+#include <limits>
 
 using namespace godot;
 
+// Boxes closer than this (pixels) to a tile touch it without overlapping,
+// so movers resting on or sliding along tiles don't snag on float error
+static constexpr float TILE_CONTACT_EPSILON = 0.01f;
+
+// Entry / exit time of a box interval moving by `delta` against a tile
+// interval; false if they never overlap during the move
+static inline bool sweep_axis(float box_min, float box_max, float tile_min, float tile_max, float delta,
+                              float& entry, float& exit) {
+    if (delta > 0.0f) {
+        entry = (tile_min - box_max) / delta;
+        exit = (tile_max - box_min) / delta;
+    } else if (delta < 0.0f) {
+        entry = (tile_max - box_min) / delta;
+        exit = (tile_min - box_max) / delta;
+    } else {
+        if (box_max <= tile_min + TILE_CONTACT_EPSILON || box_min >= tile_max - TILE_CONTACT_EPSILON) {
+            return false;
+        }
+        entry = -std::numeric_limits<float>::infinity();
+        exit = std::numeric_limits<float>::infinity();
+    }
+    return exit > 0.0f;
+}
+
 Vector2i ChunkManager::wrap_chunk_pos(Vector2i chunk_pos) const {
-    int wrapped_x = chunk_pos.x;
-    while (wrapped_x < 0) wrapped_x += CHUNKS_HORIZONTAL;
-    wrapped_x = wrapped_x % CHUNKS_HORIZONTAL;
-    return Vector2i(wrapped_x, chunk_pos.y);
+    return WorldCoords::wrap_chunk_x(chunk_pos);
 }
 
 bool ChunkManager::is_valid_chunk_y(int chunk_y) const {
@@ -101,10 +125,38 @@ Chunk2D* ChunkManager::load_chunk(Vector2i chunk_pos) {
 
     Chunk2D* chunk_ptr = chunk.get();
     chunks[wrapped_pos] = std::move(chunk);
+    link_neighbors(chunk_ptr);
 
     return chunk_ptr;
 }
 
+void ChunkManager::link_neighbors(Chunk2D* chunk) {
+    // get_chunk wraps X, so chunks at x = 0 and x = CHUNKS_HORIZONTAL - 1 are neighbors
+    for (int dy = -1; dy <= 1; dy++) {
+        for (int dx = -1; dx <= 1; dx++) {
+            if (dx == 0 && dy == 0) {
+                continue;
+            }
+            Chunk2D* neighbor = get_chunk(chunk->chunk_position + Vector2i(dx, dy));
+            chunk->set_neighbor(dx, dy, neighbor);
+            if (neighbor) {
+                neighbor->set_neighbor(-dx, -dy, chunk);
+            }
+        }
+    }
+}
+
+void ChunkManager::unlink_neighbors(Chunk2D* chunk) {
+    for (int dy = -1; dy <= 1; dy++) {
+        for (int dx = -1; dx <= 1; dx++) {
+            Chunk2D* neighbor = chunk->get_neighbor(dx, dy);
+            if (neighbor && neighbor != chunk) {
+                neighbor->set_neighbor(-dx, -dy, nullptr);
+            }
+        }
+    }
+}
+
 void ChunkManager::unload_distant_chunks(Vector2i center_chunk) {
     // Calculate unload distance (slightly larger than view distance)
     int unload_dist_h = view_distance_horizontal + 2;
@@ -132,24 +184,26 @@ void ChunkManager::unload_distant_chunks(Vector2i center_chunk) {
     // Unload chunks
     for (const auto& pos : to_unload) {
         // TODO: Save to disk before unloading if modified
-        chunks.erase(pos);
+        auto it = chunks.find(pos);
+        unlink_neighbors(it->second.get());
+        chunks.erase(it);
     }
 }
 
-Block2D* ChunkManager::get_block_at_tile(Vector2i tile_pos, bool is_background) {
+BlockView ChunkManager::get_block_at_tile(Vector2i tile_pos, bool is_background) const {
     // Wrap X coordinate
     tile_pos = WorldCoords::wrap_tile_x(tile_pos);
 
     // Check Y bounds
     if (!WorldCoords::is_valid_y(tile_pos.y)) {
-        return nullptr;
+        return BlockView();
     }
 
     // Get chunk
     Vector2i chunk_pos = WorldCoords::tile_to_chunk(tile_pos);
-    Chunk2D* chunk = get_chunk(chunk_pos);
+    const Chunk2D* chunk = get_chunk(chunk_pos);
     if (!chunk) {
-        return nullptr;
+        return BlockView();
     }
 
     // Get local position in chunk
@@ -157,28 +211,123 @@ Block2D* ChunkManager::get_block_at_tile(Vector2i tile_pos, bool is_background)
     return chunk->get_block(local_pos, is_background);
 }
 
-const Block2D* ChunkManager::get_block_at_tile(Vector2i tile_pos, bool is_background) const {
-    // Wrap X coordinate
+uint16_t ChunkManager::get_block_type_at_tile(Vector2i tile_pos, bool is_background) const {
     tile_pos = WorldCoords::wrap_tile_x(tile_pos);
-
-    // Check Y bounds
     if (!WorldCoords::is_valid_y(tile_pos.y)) {
-        return nullptr;
+        return 0;
     }
 
-    // Get chunk
-    Vector2i chunk_pos = WorldCoords::tile_to_chunk(tile_pos);
-    const Chunk2D* chunk = get_chunk(chunk_pos);
+    const Chunk2D* chunk = get_chunk(WorldCoords::tile_to_chunk(tile_pos));
     if (!chunk) {
-        return nullptr;
+        return 0;
     }
 
-    // Get local position in chunk
-    Vector2i local_pos = WorldCoords::tile_to_local(tile_pos);
-    return chunk->get_block(local_pos, is_background);
+    const Vector2i local_pos = WorldCoords::tile_to_local(tile_pos);
+    const ChunkBlockPlane& plane = is_background ? chunk->background : chunk->foreground;
+    return plane.get_type(local_pos.x, local_pos.y);
 }
 
-void ChunkManager::set_block_at_tile(Vector2i tile_pos, const Block2D& block, bool is_background) {
+void ChunkManager::set_block_at_tile(Vector2i tile_pos, const Block2D& block, bool is_background, BlockChangeCause cause) {
+    if (has_multi_tile_types) {
+        remove_multi_tile(tile_pos, is_background, cause);
+        if (is_multi_tile(block.type_id)) {
+            write_multi_tile(WorldCoords::wrap_tile_x(tile_pos), block, is_background, cause);
+            return;
+        }
+    }
+    write_tile(tile_pos, block, is_background, cause);
+}
+
+bool ChunkManager::get_multi_tile_origin(Vector2i tile_pos, bool is_background, Vector2i& origin) const {
+    const BlockView block = get_block_at_tile(tile_pos, is_background);
+    if (!block || !is_multi_tile(block->type_id)) {
+        return false;
+    }
+    origin = WorldCoords::wrap_tile_x(tile_pos - block->get_part_offset());
+    return true;
+}
+
+bool ChunkManager::place_multi_tile(Vector2i origin, const Block2D& block, bool is_background, BlockChangeCause cause) {
+    origin = WorldCoords::wrap_tile_x(origin);
+    const Vector2i size = get_block_footprint(block.type_id);
+    if (!WorldCoords::is_valid_y(origin.y) || !WorldCoords::is_valid_y(origin.y + size.y - 1)) {
+        return false;
+    }
+    for (int dy = 0; dy < size.y; dy++) {
+        for (int dx = 0; dx < size.x; dx++) {
+            if (get_block_type_at_tile(origin + Vector2i(dx, dy), is_background) != 0) {
+                return false;
+            }
+        }
+    }
+
+    if (is_multi_tile(block.type_id)) {
+        write_multi_tile(origin, block, is_background, cause);
+    } else {
+        write_tile(origin, block, is_background, cause);
+    }
+    return true;
+}
+
+bool ChunkManager::remove_multi_tile(Vector2i tile_pos, bool is_background, BlockChangeCause cause) {
+    const BlockView covered = get_block_at_tile(tile_pos, is_background);
+    if (!covered || !is_multi_tile(covered->type_id)) {
+        return false;
+    }
+
+    const uint16_t type_id = covered->type_id;
+    const Vector2i origin = WorldCoords::wrap_tile_x(tile_pos - covered->get_part_offset());
+    const Vector2i size = get_block_footprint(type_id);
+    const Block2D air;
+    for (int dy = 0; dy < size.y; dy++) {
+        for (int dx = 0; dx < size.x; dx++) {
+            // Only tiles still holding this part (a partly overwritten object
+            // may have lost some); write_tile drops each foreground part's health with it
+            const Vector2i part(dx, dy);
+            const BlockView block = get_block_at_tile(origin + part, is_background);
+            if (block && block->type_id == type_id && block->get_part_offset() == part) {
+                write_tile(origin + part, air, is_background, cause);
+            }
+        }
+    }
+
+    Chunk2D* chunk = get_chunk(WorldCoords::tile_to_chunk(origin));
+    if (chunk) {
+        const Vector2i local = WorldCoords::tile_to_local(origin);
+        chunk->anchors.remove(local.x, local.y, is_background);
+    }
+    return true;
+}
+
+void ChunkManager::write_multi_tile(Vector2i origin, const Block2D& block, bool is_background, BlockChangeCause cause) {
+    const Vector2i size = get_block_footprint(block.type_id);
+    if (!WorldCoords::is_valid_y(origin.y) || !WorldCoords::is_valid_y(origin.y + size.y - 1)) {
+        return;
+    }
+
+    // Objects the footprint overlaps go first
+    for (int dy = 0; dy < size.y; dy++) {
+        for (int dx = 0; dx < size.x; dx++) {
+            remove_multi_tile(origin + Vector2i(dx, dy), is_background, cause);
+        }
+    }
+
+    Block2D part = block;
+    for (int dy = 0; dy < size.y; dy++) {
+        for (int dx = 0; dx < size.x; dx++) {
+            part.set_part_offset(Vector2i(dx, dy));
+            write_tile(origin + Vector2i(dx, dy), part, is_background, cause);
+        }
+    }
+
+    Chunk2D* chunk = get_chunk(WorldCoords::tile_to_chunk(origin));
+    if (chunk) {
+        const Vector2i local = WorldCoords::tile_to_local(origin);
+        chunk->anchors.add(local.x, local.y, block.type_id, is_background);
+    }
+}
+
+void ChunkManager::write_tile(Vector2i tile_pos, const Block2D& block, bool is_background, BlockChangeCause cause) {
     // Wrap X coordinate
     tile_pos = WorldCoords::wrap_tile_x(tile_pos);
 
@@ -199,23 +348,48 @@ void ChunkManager::set_block_at_tile(Vector2i tile_pos, const Block2D& block, bo
 
     // Set block
     Vector2i local_pos = WorldCoords::tile_to_local(tile_pos);
+    const ChunkBlockPlane& plane = is_background ? chunk->background : chunk->foreground;
+    uint16_t old_type = plane.get_type(local_pos.x, local_pos.y);
+    if (block_events.is_enabled()) {
+        block_events.push(tile_pos, old_type, block.type_id, cause, is_background);
+    }
     chunk->set_block(local_pos, block, is_background);
+
+    // Damage belongs to the block that took it: a new type starts at full health
+    // (this also clears every part of a removed multi-tile object). The health
+    // store is shared by both layers and belongs to the foreground, so
+    // background writes leave it alone.
+    if (!is_background && old_type != block.type_id && !chunk->block_health.empty()) {
+        chunk->set_health(local_pos, 100.0f, 100.0f);
+    }
+
+    if (!is_background) {
+        const uint32_t bit = 1u << local_pos.x;
+        const TileCollisionKind kind = get_collision_kind(block);
+        uint32_t& solid = chunk->solid_rows[local_pos.y];
+        uint32_t& platform = chunk->platform_rows[local_pos.y];
+        solid = kind == TILE_COLLISION_SOLID ? (solid | bit) : (solid & ~bit);
+        platform = kind == TILE_COLLISION_PLATFORM ? (platform | bit) : (platform & ~bit);
+        const uint32_t row_bit = 1u << local_pos.y;
+        chunk->collision_row_summary = (solid | platform) != 0 ? (chunk->collision_row_summary | row_bit)
+                                                                : (chunk->collision_row_summary & ~row_bit);
+    }
 }
 
-BlockHealth* ChunkManager::get_block_health(Vector2i tile_pos) {
+bool ChunkManager::get_block_health(Vector2i tile_pos, BlockHealth& out, float max_health) {
     tile_pos = WorldCoords::wrap_tile_x(tile_pos);
     if (!WorldCoords::is_valid_y(tile_pos.y)) {
-        return nullptr;
+        return false;
     }
 
     Vector2i chunk_pos = WorldCoords::tile_to_chunk(tile_pos);
     Chunk2D* chunk = get_chunk(chunk_pos);
     if (!chunk) {
-        return nullptr;
+        return false;
     }
 
     Vector2i local_pos = WorldCoords::tile_to_local(tile_pos);
-    return chunk->get_health(local_pos);
+    return chunk->get_health(local_pos, out, max_health);
 }
 
 void ChunkManager::set_block_health(Vector2i tile_pos, float health, float max_health) {
@@ -256,20 +430,20 @@ void ChunkManager::damage_block(Vector2i tile_pos, float damage, float max_healt
     chunk->damage_block(local_pos, damage, max_health);
 }
 
-Chunk2D::LiquidCell* ChunkManager::get_liquid_at_tile(Vector2i tile_pos) {
+bool ChunkManager::get_liquid_at_tile(Vector2i tile_pos, Chunk2D::LiquidCell& out) const {
     tile_pos = WorldCoords::wrap_tile_x(tile_pos);
     if (!WorldCoords::is_valid_y(tile_pos.y)) {
-        return nullptr;
+        return false;
     }
 
     Vector2i chunk_pos = WorldCoords::tile_to_chunk(tile_pos);
-    Chunk2D* chunk = get_chunk(chunk_pos);
+    const Chunk2D* chunk = get_chunk(chunk_pos);
     if (!chunk) {
-        return nullptr;
+        return false;
     }
 
     Vector2i local_pos = WorldCoords::tile_to_local(tile_pos);
-    return chunk->get_liquid(local_pos);
+    return chunk->get_liquid(local_pos, out);
 }
 
 void ChunkManager::set_liquid_at_tile(Vector2i tile_pos, LiquidType type, float level) {
@@ -291,6 +465,393 @@ void ChunkManager::set_liquid_at_tile(Vector2i tile_pos, LiquidType type, float
     chunk->set_liquid(local_pos, type, level);
 }
 
+void ChunkManager::set_block_registry(const BlockRegistry* registry) {
+    block_registry = registry;
+    collision_table.clear();
+    refresh_collision_rows();
+}
+
+void ChunkManager::refresh_collision_rows() {
+    if (!block_registry || (!collision_table.empty() && registry_version == block_registry->get_version())) {
+        return;
+    }
+    registry_version = block_registry->get_version();
+
+    const size_t type_count = static_cast<size_t>(block_registry->get_max_block_id()) + 1;
+    collision_table.assign(type_count, TILE_COLLISION_NONE);
+    for (const auto& pair : block_registry->get_all_blocks()) {
+        if (pair.first >= type_count) {
+            continue;
+        }
+        const BlockDefinition& def = pair.second;
+        collision_table[pair.first] = def.is_platform ? TILE_COLLISION_PLATFORM
+                                    : def.is_solid ? TILE_COLLISION_SOLID : TILE_COLLISION_NONE;
+    }
+    collision_table[0] = TILE_COLLISION_NONE;
+
+    // Multi-tile footprints (sizes past Block2D::MAX_PART_SIZE are clamped)
+    footprint_table.assign(type_count, 0);
+    has_multi_tile_types = false;
+    for (const auto& pair : block_registry->get_all_blocks()) {
+        if (pair.first == 0 || pair.first >= type_count) {
+            continue;
+        }
+        const Vector2i size = pair.second.size;
+        const int width = std::clamp(size.x, 1, Block2D::MAX_PART_SIZE);
+        const int height = std::clamp(size.y, 1, Block2D::MAX_PART_SIZE);
+        footprint_table[pair.first] = static_cast<uint8_t>((width - 1) | ((height - 1) << 2));
+        has_multi_tile_types |= footprint_table[pair.first] != 0;
+    }
+
+    for (const auto& pair : chunks) {
+        build_collision_rows(pair.second.get());
+    }
+    collision_revision++;
+}
+
+TileCollisionKind ChunkManager::get_collision_kind(const Block2D& block) const {
+    if (block.type_id == 0 || block.has_flag(Block2D::IS_LIQUID)) {
+        return TILE_COLLISION_NONE;
+    }
+    TileCollisionKind kind = block.type_id < collision_table.size()
+        ? static_cast<TileCollisionKind>(collision_table[block.type_id]) : TILE_COLLISION_SOLID;
+    if (kind == TILE_COLLISION_SOLID && block.has_flag(Block2D::IS_PLATFORM)) {
+        kind = TILE_COLLISION_PLATFORM;
+    }
+    return kind;
+}
+
+void ChunkManager::build_collision_rows(Chunk2D* chunk) const {
+    // A chunk holds a few types (occupancy histogram): OR each colliding
+    // type's row masks from the type plane, then apply the liquid / platform
+    // flags as row masks too
+    const ChunkBlockPlane& plane = chunk->foreground;
+    chunk->solid_rows.fill(0);
+    chunk->platform_rows.fill(0);
+    chunk->collision_row_summary = 0;
+    for (const ChunkOccupancy::TypeCount& entry : chunk->foreground_occupancy.get_type_counts()) {
+        const TileCollisionKind kind = entry.type_id < collision_table.size()
+            ? static_cast<TileCollisionKind>(collision_table[entry.type_id]) : TILE_COLLISION_SOLID;
+        if (kind == TILE_COLLISION_NONE) {
+            continue;
+        }
+        std::array<uint32_t, CHUNK_HEIGHT>& rows = kind == TILE_COLLISION_SOLID ? chunk->solid_rows : chunk->platform_rows;
+        for (int y = 0; y < CHUNK_HEIGHT; y++) {
+            rows[y] |= plane.get_type_row(y, entry.type_id);
+        }
+    }
+
+    // Liquids never collide; solid types flagged IS_PLATFORM are platforms
+    const bool any_flags = chunk->foreground_occupancy.get_flag_count(Block2D::IS_LIQUID) != 0 ||
+                           chunk->foreground_occupancy.get_flag_count(Block2D::IS_PLATFORM) != 0;
+    for (int y = 0; y < CHUNK_HEIGHT; y++) {
+        if (any_flags) {
+            const uint32_t liquid = plane.get_flag_row(y, Block2D::IS_LIQUID);
+            const uint32_t platform_flag = plane.get_flag_row(y, Block2D::IS_PLATFORM);
+            chunk->platform_rows[y] = (chunk->platform_rows[y] | (chunk->solid_rows[y] & platform_flag)) & ~liquid;
+            chunk->solid_rows[y] &= ~(platform_flag | liquid);
+        }
+        if ((chunk->solid_rows[y] | chunk->platform_rows[y]) != 0) {
+            chunk->collision_row_summary |= 1u << y;
+        }
+    }
+}
+
+void ChunkManager::get_collision_row(int first_x, int tile_y, uint32_t& solid, uint32_t& platform) const {
+    // Outside the world is a wall
+    if (!WorldCoords::is_valid_y(tile_y)) {
+        solid = 0xFFFFFFFFu;
+        platform = 0;
+        return;
+    }
+
+    const int chunk_x = WorldGrid::chunk_x(first_x);
+    const int chunk_y = WorldGrid::chunk_y(tile_y);
+    const int local_y = WorldGrid::local_y(tile_y);
+    const int shift = WorldGrid::local_x(first_x);
+
+    // Unloaded chunks are solid so nothing falls out of the loaded area
+    const Chunk2D* left = get_chunk(Vector2i(chunk_x, chunk_y));
+    solid = left ? left->solid_rows[local_y] >> shift : 0xFFFFFFFFu >> shift;
+    platform = left ? left->platform_rows[local_y] >> shift : 0;
+    if (shift == 0) {
+        return;
+    }
+
+    // The window reaches into the next chunk
+    const Chunk2D* right = get_chunk(Vector2i(chunk_x + 1, chunk_y));
+    solid |= (right ? right->solid_rows[local_y] : 0xFFFFFFFFu) << (CHUNK_WIDTH - shift);
+    platform |= (right ? right->platform_rows[local_y] : 0u) << (CHUNK_WIDTH - shift);
+}
+
+TileSweepResult ChunkManager::move_and_collide_tiles(const Rect2& aabb, Vector2 motion, bool collide_platforms) const {
+    TileSweepResult result;
+    result.travel = motion;
+    if (motion.x == 0.0f && motion.y == 0.0f) {
+        return result;
+    }
+
+    const float tile_size = static_cast<float>(TILE_SIZE_PIXELS);
+    const float left = aabb.position.x;
+    const float top = aabb.position.y;
+    const float right = left + aabb.size.x;
+    const float bottom = top + aabb.size.y;
+
+    // Tiles the swept box can reach (touching tiles excluded)
+    const int first_x = static_cast<int>(std::floor((std::min(left, left + motion.x) + TILE_CONTACT_EPSILON) / tile_size));
+    const int last_x = static_cast<int>(std::floor((std::max(right, right + motion.x) - TILE_CONTACT_EPSILON) / tile_size));
+    const int first_y = static_cast<int>(std::floor((std::min(top, top + motion.y) + TILE_CONTACT_EPSILON) / tile_size));
+    const int last_y = static_cast<int>(std::floor((std::max(bottom, bottom + motion.y) - TILE_CONTACT_EPSILON) / tile_size));
+    if (first_x > last_x || first_y > last_y) {
+        return result;
+    }
+
+    // Platforms only catch boxes falling onto them
+    const bool platforms = collide_platforms && motion.y * DOWN_Y > 0.0f;
+
+    // Rows in the direction of motion: once a row's entry time is past the
+    // best hit, every later row is too
+    const int step_y = motion.y < 0.0f ? -1 : 1;
+    const int row_count = last_y - first_y + 1;
+    float best = 1.0f;
+    Vector2i hit_tile;
+    bool hit_x = false;
+    for (int i = 0; i < row_count; i++) {
+        const int ty = step_y > 0 ? first_y + i : last_y - i;
+        const float tile_top = ty * tile_size;
+        float entry_y, exit_y;
+        if (!sweep_axis(top, bottom, tile_top, tile_top + tile_size, motion.y, entry_y, exit_y)) {
+            continue;
+        }
+        if (entry_y > best) {
+            break;
+        }
+        // ...and only if the box starts on the far side of the platform's upper face
+        const bool row_platforms = platforms && (DOWN_Y > 0 ? bottom <= tile_top + TILE_CONTACT_EPSILON
+                                                            : top >= tile_top + tile_size - TILE_CONTACT_EPSILON);
+
+        for (int window_x = first_x; window_x <= last_x; window_x += CHUNK_WIDTH) {
+            uint32_t solid, platform;
+            get_collision_row(window_x, ty, solid, platform);
+            const int columns = std::min(last_x - window_x + 1, CHUNK_WIDTH);
+            const uint32_t window = columns == CHUNK_WIDTH ? 0xFFFFFFFFu : (1u << columns) - 1;
+
+            uint32_t bits = (solid | (row_platforms ? platform : 0u)) & window;
+            for (; bits != 0; bits &= bits - 1) {
+                int bit = 0;
+                while (((bits >> bit) & 1u) == 0) {
+                    bit++;
+                }
+                const int tx = window_x + bit;
+                const float tile_left = tx * tile_size;
+                float entry_x, exit_x;
+                if (!sweep_axis(left, right, tile_left, tile_left + tile_size, motion.x, entry_x, exit_x)) {
+                    continue;
+                }
+
+                const float entry = std::max(entry_x, entry_y);
+                if (entry >= std::min(exit_x, exit_y) || entry > best || (result.hit && entry == best)) {
+                    continue;
+                }
+
+                // Tiles the box already overlaps don't block (lets stuck movers out)
+                const bool along_x = entry_x > entry_y;
+                const float penetration = -entry * std::abs(along_x ? motion.x : motion.y);
+                if (penetration > TILE_CONTACT_EPSILON) {
+                    continue;
+                }
+                // Platforms are only landed on
+                if (along_x && ((platform >> bit) & 1u) && !((solid >> bit) & 1u)) {
+                    continue;
+                }
+
+                best = entry;
+                hit_tile = Vector2i(tx, ty);
+                hit_x = along_x;
+                result.hit = true;
+            }
+        }
+    }
+
+    if (!result.hit) {
+        return result;
+    }
+
+    // Snap the contact edge onto the tile so the next move starts exactly touching
+    result.time = std::max(best, 0.0f);
+    result.travel = motion * result.time;
+    if (hit_x) {
+        const float tile_left = hit_tile.x * tile_size;
+        result.normal = Vector2(motion.x > 0.0f ? -1.0f : 1.0f, 0.0f);
+        result.travel.x = motion.x > 0.0f ? tile_left - right : tile_left + tile_size - left;
+    } else {
+        const float tile_top = hit_tile.y * tile_size;
+        result.normal = Vector2(0.0f, motion.y > 0.0f ? -1.0f : 1.0f);
+        result.travel.y = motion.y > 0.0f ? tile_top - bottom : tile_top + tile_size - top;
+    }
+    result.remainder = motion - result.travel;
+    result.tile = WorldCoords::wrap_tile_x(hit_tile);
+    return result;
+}
+
+TileSlideResult ChunkManager::move_and_slide_tiles(const Rect2& aabb, Vector2 motion, bool collide_platforms,
+                                                   int max_slides) const {
+    TileSlideResult result;
+    Rect2 box = aabb;
+    Vector2 remaining = motion;
+    for (int i = 0; i < max_slides && (remaining.x != 0.0f || remaining.y != 0.0f); i++) {
+        const TileSweepResult sweep = move_and_collide_tiles(box, remaining, collide_platforms);
+        box.position += sweep.travel;
+        result.travel += sweep.travel;
+        remaining = Vector2(0.0f, 0.0f);
+        if (!sweep.hit) {
+            break;
+        }
+
+        // Drop the motion into the contact, keep the part along it
+        result.collisions++;
+        if (sweep.normal.x != 0.0f) {
+            result.on_wall = true;
+            result.remainder.x += sweep.remainder.x;
+            remaining.y = sweep.remainder.y;
+        } else {
+            result.on_floor = result.on_floor || sweep.normal.y * DOWN_Y < 0.0f;
+            result.on_ceiling = result.on_ceiling || sweep.normal.y * DOWN_Y > 0.0f;
+            result.remainder.y += sweep.remainder.y;
+            remaining.x = sweep.remainder.x;
+        }
+    }
+    result.remainder += remaining;
+    return result;
+}
+
+TileRayHit ChunkManager::raycast_tiles(Vector2 from, Vector2 to, bool hit_platforms) const {
+    TileRayHit result;
+    const float tile_size = static_cast<float>(TILE_SIZE_PIXELS);
+    const float infinity = std::numeric_limits<float>::infinity();
+
+    const Vector2 delta = to - from;
+    const float length = std::sqrt(delta.x * delta.x + delta.y * delta.y);
+    const float dir_x = length > 0.0f ? delta.x / length : 0.0f;
+    const float dir_y = length > 0.0f ? delta.y / length : 0.0f;
+
+    // Distances along the ray (pixels) to the next tile line on each axis,
+    // and between two lines of the same axis
+    int tx = static_cast<int>(std::floor(from.x / tile_size));
+    int ty = static_cast<int>(std::floor(from.y / tile_size));
+    const int step_x = dir_x < 0.0f ? -1 : 1;
+    const int step_y = dir_y < 0.0f ? -1 : 1;
+    const float t_delta_x = dir_x != 0.0f ? tile_size / std::abs(dir_x) : infinity;
+    const float t_delta_y = dir_y != 0.0f ? tile_size / std::abs(dir_y) : infinity;
+    float t_max_x = dir_x > 0.0f ? ((tx + 1) * tile_size - from.x) / dir_x
+                  : dir_x < 0.0f ? (tx * tile_size - from.x) / dir_x : infinity;
+    float t_max_y = dir_y > 0.0f ? ((ty + 1) * tile_size - from.y) / dir_y
+                  : dir_y < 0.0f ? (ty * tile_size - from.y) / dir_y : infinity;
+
+    // The chunk under the ray is only looked up when the ray enters a new one
+    Vector2i chunk_pos = WorldCoords::tile_to_chunk(Vector2i(tx, ty));
+    const Chunk2D* chunk = get_chunk(chunk_pos);
+    float t = 0.0f;
+    int face = -1;      // Axis of the last step (0 = X, 1 = Y)
+
+    while (t <= length) {
+        const Vector2i tile_chunk = WorldCoords::tile_to_chunk(Vector2i(tx, ty));
+        if (tile_chunk != chunk_pos) {
+            chunk_pos = tile_chunk;
+            chunk = get_chunk(chunk_pos);
+        }
+
+        if (!chunk || chunk->collision_row_summary == 0) {
+            // Nothing to hit in this chunk: jump to the tile the ray leaves it from
+            const int crossings_x = step_x > 0 ? CHUNK_WIDTH - WorldGrid::local_x(tx) : WorldGrid::local_x(tx) + 1;
+            const int crossings_y = step_y > 0 ? CHUNK_HEIGHT - WorldGrid::local_y(ty) : WorldGrid::local_y(ty) + 1;
+            const float exit_x = dir_x != 0.0f ? t_max_x + (crossings_x - 1) * t_delta_x : infinity;
+            const float exit_y = dir_y != 0.0f ? t_max_y + (crossings_y - 1) * t_delta_y : infinity;
+            if (exit_x < exit_y) {
+                t = exit_x;
+                tx += step_x * crossings_x;
+                t_max_x = exit_x + t_delta_x;
+                // Y lines crossed on the way (at or before the exit, like single steps)
+                const int skipped = t_max_y <= t ? static_cast<int>((t - t_max_y) / t_delta_y) + 1 : 0;
+                if (skipped > 0) {
+                    ty += step_y * skipped;
+                    t_max_y += skipped * t_delta_y;
+                }
+                face = 0;
+            } else {
+                if (exit_y == infinity) {
+                    break;
+                }
+                t = exit_y;
+                ty += step_y * crossings_y;
+                t_max_y = exit_y + t_delta_y;
+                const int skipped = t_max_x < t ? static_cast<int>((t - t_max_x) / t_delta_x) + 1 : 0;
+                if (skipped > 0) {
+                    tx += step_x * skipped;
+                    t_max_x += skipped * t_delta_x;
+                }
+                face = 1;
+            }
+            continue;
+        }
+
+        const int local_x = WorldGrid::local_x(tx);
+        const int local_y = WorldGrid::local_y(ty);
+        const uint32_t row = chunk->solid_rows[local_y] | (hit_platforms ? chunk->platform_rows[local_y] : 0u);
+        if ((row >> local_x) & 1u) {
+            result.hit = true;
+            result.tile = WorldCoords::wrap_tile_x(Vector2i(tx, ty));
+            result.normal = face == 0 ? Vector2i(-step_x, 0) : face == 1 ? Vector2i(0, -step_y) : Vector2i(0, 0);
+            result.distance = t;
+            result.position = from + Vector2(dir_x, dir_y) * t;
+            return result;
+        }
+
+        if (t_max_x < t_max_y) {
+            t = t_max_x;
+            t_max_x += t_delta_x;
+            tx += step_x;
+            face = 0;
+        } else {
+            if (t_max_y == infinity) {
+                break;
+            }
+            t = t_max_y;
+            t_max_y += t_delta_y;
+            ty += step_y;
+            face = 1;
+        }
+    }
+    return result;
+}
+
+void ChunkManager::raycast_tiles_batch(const Vector2* from, const Vector2* to, size_t count, TileRayHit* out,
+                                       bool hit_platforms) const {
+    for (size_t i = 0; i < count; i++) {
+        out[i] = raycast_tiles(from[i], to[i], hit_platforms);
+    }
+}
+
+int64_t ChunkManager::count_blocks(uint16_t type_id, const Rect2i& chunk_region, bool is_background) const {
+    if (type_id == 0) {
+        return 0;
+    }
+
+    // A region wider than the world would count chunks twice
+    const int width = std::min(chunk_region.size.x, CHUNKS_HORIZONTAL);
+    int64_t total = 0;
+    for (int cy = chunk_region.position.y; cy < chunk_region.position.y + chunk_region.size.y; cy++) {
+        for (int cx = chunk_region.position.x; cx < chunk_region.position.x + width; cx++) {
+            const Chunk2D* chunk = get_chunk(Vector2i(cx, cy));
+            if (chunk) {
+                const ChunkOccupancy& occupancy = is_background ? chunk->background_occupancy : chunk->foreground_occupancy;
+                total += occupancy.get_type_count(type_id);
+            }
+        }
+    }
+    return total;
+}
+
 bool ChunkManager::has_chunk(Vector2i chunk_pos) const {
     Vector2i wrapped_pos = wrap_chunk_pos(chunk_pos);
     if (!is_valid_chunk_y(wrapped_pos.y)) {
@@ -309,6 +870,7 @@ size_t ChunkManager::get_total_memory_usage() const {
 
 void ChunkManager::clear_all() {
     chunks.clear();
+    block_events.clear();
     generation_queue.clear();
     last_camera_chunk = Vector2i(-9999, -9999);
 }
@@ -4,18 +4,71 @@
 #include "../world/chunk_2d.h"
 #include "../world/world_constants.h"
 #include "../world/block_data.h"
+#include "block_events.h"
 #include <godot_cpp/classes/node2d.hpp>
 #include <godot_cpp/variant/rect2.hpp>
+#include <godot_cpp/variant/rect2i.hpp>
 #include <memory>
-#include <unordered_map>
+#include "../utils/flat_hash_map.h"
 #include <vector>
 
 using namespace godot;
 
+class BlockRegistry;
+
+// How a foreground tile collides with movers
+enum TileCollisionKind : uint8_t {
+    TILE_COLLISION_NONE = 0,        // Air, liquids, non-solid blocks (torches)
+    TILE_COLLISION_SOLID = 1,
+    TILE_COLLISION_PLATFORM = 2     // One-way: only stops movers coming from above
+};
+
+// Result of one swept move through the tile grid (pixels)
+struct TileSweepResult {
+    bool hit;
+    float time;             // Fraction of the motion travelled (1 without a hit)
+    Vector2 travel;         // Motion applied up to the contact
+    Vector2 remainder;      // Motion left after the contact
+    Vector2 normal;         // Contact normal (zero without a hit)
+    Vector2i tile;          // Tile hit (wrapped)
+
+    TileSweepResult()
+        : hit(false), time(1.0f), travel(0, 0), remainder(0, 0), normal(0, 0), tile(0, 0) {}
+};
+
+// Result of a sliding move (the motion is projected along each contact)
+struct TileSlideResult {
+    Vector2 travel;         // Total motion applied
+    Vector2 remainder;      // Motion stopped by contacts
+    bool on_floor;
+    bool on_wall;
+    bool on_ceiling;
+    int collisions;
+
+    TileSlideResult()
+        : travel(0, 0), remainder(0, 0), on_floor(false), on_wall(false), on_ceiling(false), collisions(0) {}
+};
+
+// First tile a ray hits (pixels)
+struct TileRayHit {
+    bool hit;
+    Vector2i tile;          // Tile hit (wrapped)
+    Vector2i normal;        // Face the ray entered through, pointing back at the ray ((0, 0) if it started inside)
+    float distance;         // From the ray origin to the hit point
+    Vector2 position;       // Hit point (unwrapped, like the ray)
+
+    TileRayHit() : hit(false), tile(0, 0), normal(0, 0), distance(0.0f), position(0, 0) {}
+};
+
+// Loaded chunks by (wrapped) chunk position
+// Open addressing keeps the lookup behind every tile access to a slot or two;
+// chunks are heap-allocated so their pointers stay valid as the table moves.
+using ChunkMap = FlatHashMap<Vector2i, std::unique_ptr<Chunk2D>, Vector2iHash>;
+
 class ChunkManager {
 private:
     // Active chunks stored by chunk position
-    std::unordered_map<Vector2i, std::unique_ptr<Chunk2D>, Vector2iHash> chunks;
+    ChunkMap chunks;
 
     // Chunks queued for generation
     std::vector<Vector2i> generation_queue;
@@ -27,6 +80,19 @@ private:
     // Last camera chunk position (for detecting movement)
     Vector2i last_camera_chunk;
 
+    // Block changes recorded this frame
+    BlockEventStream block_events;
+
+    // Per block type TileCollisionKind (optional registry, flags only without it)
+    const BlockRegistry* block_registry = nullptr;
+    std::vector<uint8_t> collision_table;
+    uint32_t registry_version = 0;
+
+    // Per block type footprint, (width - 1) | (height - 1) << 2 (0 = single tile)
+    std::vector<uint8_t> footprint_table;
+    bool has_multi_tile_types = false;
+    uint32_t collision_revision = 0;
+
 public:
     ChunkManager() : last_camera_chunk(Vector2i(-9999, -9999)) {}
     ~ChunkManager() = default;
@@ -44,27 +110,101 @@ public:
     // Unload distant chunks
     void unload_distant_chunks(Vector2i center_chunk);
 
-    // Block access by tile coordinates (handles wrapping and chunk lookup)
-    Block2D* get_block_at_tile(Vector2i tile_pos, bool is_background = false);
-    const Block2D* get_block_at_tile(Vector2i tile_pos, bool is_background = false) const;
+    // Block access by tile coordinates (handles wrapping and chunk lookup;
+    // invalid view outside the world or where no chunk is loaded)
+    BlockView get_block_at_tile(Vector2i tile_pos, bool is_background = false) const;
+
+    // Block type only, read straight from the type plane (0 where no chunk is loaded)
+    uint16_t get_block_type_at_tile(Vector2i tile_pos, bool is_background = false) const;
+
+    // Set block at tile coordinates (recorded in the block event stream)
+    // Overwriting any tile of a multi-tile object removes the whole object; a
+    // multi-tile type is written as a whole object with its origin at tile_pos,
+    // replacing whatever its footprint covered
+    void set_block_at_tile(Vector2i tile_pos, const Block2D& block, bool is_background = false,
+                           BlockChangeCause cause = CAUSE_PLACED);
+
+    // Multi-tile objects (BlockDefinition::size above 1x1; the origin is the
+    // top-left tile). Each tile stores its offset from the origin, so every
+    // query below is O(1) and place / remove are O(size), across chunk borders.
+    // Size in tiles of a block type (1x1 for single-tile and unknown types)
+    inline Vector2i get_block_footprint(uint16_t type_id) const {
+        const uint8_t packed = type_id < footprint_table.size() ? footprint_table[type_id] : 0;
+        return Vector2i((packed & 3) + 1, (packed >> 2) + 1);
+    }
+    inline bool is_multi_tile(uint16_t type_id) const {
+        return type_id < footprint_table.size() && footprint_table[type_id] != 0;
+    }
+
+    // Origin of the multi-tile object covering tile_pos (false if the tile isn't part of one)
+    bool get_multi_tile_origin(Vector2i tile_pos, bool is_background, Vector2i& origin) const;
 
-    // Set block at tile coordinates
-    void set_block_at_tile(Vector2i tile_pos, const Block2D& block, bool is_background = false);
+    // Place a block only if every tile of its footprint is inside the world and air
+    bool place_multi_tile(Vector2i origin, const Block2D& block, bool is_background = false,
+                          BlockChangeCause cause = CAUSE_PLACED);
+
+    // Turn every tile of the object covering tile_pos into air (false if there is none)
+    bool remove_multi_tile(Vector2i tile_pos, bool is_background = false,
+                           BlockChangeCause cause = CAUSE_DESTROYED);
 
     // Get/set block health
-    BlockHealth* get_block_health(Vector2i tile_pos);
+    // Returns false if the block is undamaged; max_health comes from the block definition
+    bool get_block_health(Vector2i tile_pos, BlockHealth& out, float max_health = 100.0f);
     void set_block_health(Vector2i tile_pos, float health, float max_health = 100.0f);
     void damage_block(Vector2i tile_pos, float damage, float max_health = 100.0f);
 
-    // Liquid access
-    Chunk2D::LiquidCell* get_liquid_at_tile(Vector2i tile_pos);
+    // Liquid access (returns false if the tile holds no liquid)
+    bool get_liquid_at_tile(Vector2i tile_pos, Chunk2D::LiquidCell& out) const;
     void set_liquid_at_tile(Vector2i tile_pos, LiquidType type, float level);
 
     // Get all active chunks
-    const std::unordered_map<Vector2i, std::unique_ptr<Chunk2D>, Vector2iHash>& get_all_chunks() const {
+    const ChunkMap& get_all_chunks() const {
         return chunks;
     }
 
+    // Probe lengths of the chunk table
+    FlatHashMapStats get_chunk_map_stats() const { return chunks.get_stats(); }
+
+    // Block change stream (published once per frame)
+    BlockEventStream& get_block_events() { return block_events; }
+    const BlockEventStream& get_block_events() const { return block_events; }
+
+    // Block definitions for tile collision (is_solid, is_platform)
+    void set_block_registry(const BlockRegistry* registry);
+
+    // Reclassify every loaded chunk's collision rows if the registry changed
+    // (call once per frame before moving anything through the grid)
+    void refresh_collision_rows();
+
+    // Bumped whenever collision rows were rebuilt wholesale (registry changes)
+    uint32_t get_collision_revision() const { return collision_revision; }
+
+    TileCollisionKind get_collision_kind(const Block2D& block) const;
+
+    // Sweep a pixel AABB along motion through the tile grid (X wraps) and
+    // stop at the first solid tile. Platforms only stop downward (DOWN_Y) motion that
+    // starts above them. Unloaded chunks and rows outside the world are solid.
+    // Thread-safe while no blocks change.
+    TileSweepResult move_and_collide_tiles(const Rect2& aabb, Vector2 motion, bool collide_platforms = true) const;
+
+    // Repeated move_and_collide_tiles, sliding along each contact
+    TileSlideResult move_and_slide_tiles(const Rect2& aabb, Vector2 motion, bool collide_platforms = true,
+                                         int max_slides = 4) const;
+
+    // First solid tile (and platform if hit_platforms) on the segment from -> to
+    // (Amanatides-Woo grid walk, X wraps). Chunks without solid rows, unloaded
+    // chunks and rows outside the world are crossed in one step without a hit.
+    // Thread-safe while no blocks change.
+    TileRayHit raycast_tiles(Vector2 from, Vector2 to, bool hit_platforms = false) const;
+
+    // raycast_tiles for count rays into out
+    void raycast_tiles_batch(const Vector2* from, const Vector2* to, size_t count, TileRayHit* out,
+                             bool hit_platforms = false) const;
+
+    // Blocks of a type in a region of chunks (X wraps, unloaded chunks count 0)
+    // from the per-chunk histograms - no tiles are read
+    int64_t count_blocks(uint16_t type_id, const Rect2i& chunk_region, bool is_background = false) const;
+
     // Check if chunk exists
     bool has_chunk(Vector2i chunk_pos) const;
 
@@ -81,8 +221,25 @@ private:
     // Wrap chunk X coordinate for horizontal wrapping
     Vector2i wrap_chunk_pos(Vector2i chunk_pos) const;
 
+    // Point a new chunk and its loaded neighbors at each other / detach a chunk being unloaded
+    void link_neighbors(Chunk2D* chunk);
+    void unlink_neighbors(Chunk2D* chunk);
+
     // Check if chunk Y coordinate is valid
     bool is_valid_chunk_y(int chunk_y) const;
+
+    // Rebuild a chunk's solid / platform rows from its foreground
+    void build_collision_rows(Chunk2D* chunk) const;
+
+    // Write one tile (loading its chunk), with events and collision rows but
+    // no multi-tile bookkeeping
+    void write_tile(Vector2i tile_pos, const Block2D& block, bool is_background, BlockChangeCause cause);
+
+    // Write every tile of a multi-tile object and index its origin
+    void write_multi_tile(Vector2i origin, const Block2D& block, bool is_background, BlockChangeCause cause);
+
+    // Solid and platform masks of tile columns first_x .. first_x + 31 in one tile row
+    void get_collision_row(int first_x, int tile_y, uint32_t& solid, uint32_t& platform) const;
 };
 
 #endif // CHUNK_MANAGER_H
@@ -0,0 +1,310 @@
+#include "item_drops.h"
+#include <cmath>
+#include <algorithm>
+
+using namespace godot;
+
+ItemDropSystem::ItemDropSystem(ChunkManager* chunks, size_t max_count)
+    : chunk_manager(chunks)
+    , max_drops(max_count)
+    , merge_timer(0.0f)
+    , spawn_counter(0)
+    , cached_chunk_pos(Vector2i(-9999, -9999))
+    , cached_chunk(nullptr)
+{
+    position_x.reserve(max_drops);
+    position_y.reserve(max_drops);
+    velocity_x.reserve(max_drops);
+    velocity_y.reserve(max_drops);
+    age.reserve(max_drops);
+    item_id.reserve(max_drops);
+    stack_count.reserve(max_drops);
+    resting.reserve(max_drops);
+    hash_next.reserve(max_drops);
+}
+
+bool ItemDropSystem::spawn(Vector2 world_pos, uint16_t id, uint16_t count, Vector2 velocity) {
+    if (item_id.size() >= max_drops || count == 0) {
+        return false;
+    }
+
+    position_x.push_back(world_pos.x);
+    position_y.push_back(world_pos.y);
+    velocity_x.push_back(velocity.x);
+    velocity_y.push_back(velocity.y);
+    age.push_back(0.0f);
+    item_id.push_back(id);
+    stack_count.push_back(count);
+    resting.push_back(0);
+    return true;
+}
+
+bool ItemDropSystem::spawn_at_tile(Vector2i tile_pos, uint16_t id, uint16_t count) {
+    // Small deterministic scatter so drops from one explosion don't stack perfectly
+    spawn_counter = spawn_counter * 1103515245u + 12345u;
+    float scatter = static_cast<float>((spawn_counter >> 16) & 0xFF) / 255.0f - 0.5f;
+
+    Vector2 velocity(scatter * 80.0f, -120.0f * DOWN_Y);
+    return spawn(WorldCoords::tile_to_world(tile_pos), id, count, velocity);
+}
+
+void ItemDropSystem::update(float delta_time) {
+    // Simulate and age every drop in one pass
+    for (size_t i = 0; i < item_id.size(); i++) {
+        integrate(i, delta_time);
+        age[i] += delta_time;
+    }
+
+    // Despawn expired drops (and ones that left the world)
+    for (size_t i = item_id.size(); i-- > 0;) {
+        if (age[i] >= ITEM_DROP_LIFETIME) {
+            remove_at(i);
+        }
+    }
+
+    merge_timer += delta_time;
+    if (merge_timer >= ITEM_DROP_MERGE_INTERVAL) {
+        merge_timer = 0.0f;
+        merge_nearby();
+    }
+
+    rebuild_transform_buffer();
+}
+
+int ItemDropSystem::collect(Vector2 world_pos, float radius, PackedInt32Array& out_items) {
+    const float radius2 = radius * radius;
+    int collected = 0;
+
+    for (size_t i = item_id.size(); i-- > 0;) {
+        float dx = position_x[i] - world_pos.x;
+        float dy = position_y[i] - world_pos.y;
+        if (dx * dx + dy * dy > radius2) {
+            continue;
+        }
+
+        out_items.push_back(item_id[i]);
+        out_items.push_back(stack_count[i]);
+        remove_at(i);
+        collected++;
+    }
+
+    if (collected > 0) {
+        rebuild_transform_buffer();
+    }
+    return collected;
+}
+
+void ItemDropSystem::clear() {
+    position_x.clear();
+    position_y.clear();
+    velocity_x.clear();
+    velocity_y.clear();
+    age.clear();
+    item_id.clear();
+    stack_count.clear();
+    resting.clear();
+    transform_buffer.resize(0);
+    cached_chunk = nullptr;
+    cached_chunk_pos = Vector2i(-9999, -9999);
+}
+
+bool ItemDropSystem::is_solid_tile(int tile_x, int tile_y) {
+    if (!WorldCoords::is_valid_y(tile_y)) {
+        return false;
+    }
+
+    Vector2i tile_pos = WorldCoords::wrap_tile_x(Vector2i(tile_x, tile_y));
+    Vector2i chunk_pos = WorldCoords::tile_to_chunk(tile_pos);
+    if (chunk_pos != cached_chunk_pos) {
+        cached_chunk_pos = chunk_pos;
+        cached_chunk = chunk_manager->get_chunk(chunk_pos);
+    }
+
+    // Unloaded terrain holds drops in place instead of letting them fall forever
+    if (!cached_chunk) {
+        return true;
+    }
+
+    BlockView block = cached_chunk->get_block(WorldCoords::tile_to_local(tile_pos));
+    return block && block->type_id != 0 && !block->has_flag(Block2D::IS_LIQUID);
+}
+
+void ItemDropSystem::integrate(size_t index, float delta_time) {
+    const float tile = static_cast<float>(TILE_SIZE_PIXELS);
+    float px = position_x[index];
+    float py = position_y[index];
+    float vx = velocity_x[index];
+    float vy = velocity_y[index];
+
+    if (resting[index]) {
+        // Ground friction; wake up if the supporting tile was removed
+        vx -= vx * std::min(1.0f, ITEM_DROP_GROUND_FRICTION * delta_time);
+        int foot_y = static_cast<int>(std::floor((py + (ITEM_DROP_HALF_SIZE + 1.0f) * DOWN_Y) / tile));
+        if (!is_solid_tile(static_cast<int>(std::floor(px / tile)), foot_y)) {
+            resting[index] = 0;
+        }
+    }
+
+    if (!resting[index]) {
+        vy += GRAVITY * DOWN_Y * delta_time;
+        vy = std::clamp(vy, -MAX_FALL_SPEED, MAX_FALL_SPEED);
+    }
+
+    // Sub-step so fast drops can't tunnel through a tile
+    float travel = std::max(std::abs(vx), std::abs(vy)) * delta_time;
+    int steps = std::max(1, static_cast<int>(std::ceil(travel / (tile * 0.5f))));
+    float step_dt = delta_time / steps;
+
+    for (int s = 0; s < steps; s++) {
+        // Horizontal
+        if (vx != 0.0f) {
+            float nx = px + vx * step_dt;
+            float lead = nx + (vx > 0.0f ? ITEM_DROP_HALF_SIZE : -ITEM_DROP_HALF_SIZE);
+            int row = static_cast<int>(std::floor(py / tile));
+            if (is_solid_tile(static_cast<int>(std::floor(lead / tile)), row)) {
+                vx = 0.0f;
+            } else {
+                px = nx;
+            }
+        }
+
+        // Vertical
+        if (!resting[index] && vy != 0.0f) {
+            float ny = py + vy * step_dt;
+            bool moving_down = (vy * DOWN_Y) > 0.0f;
+            float edge = ny + (moving_down ? ITEM_DROP_HALF_SIZE * DOWN_Y : -ITEM_DROP_HALF_SIZE * DOWN_Y);
+            int tile_y = static_cast<int>(std::floor(edge / tile));
+
+            if (!WorldCoords::is_valid_y(tile_y)) {
+                // Left the world - let despawn pick it up
+                age[index] = ITEM_DROP_LIFETIME;
+                break;
+            }
+
+            if (is_solid_tile(static_cast<int>(std::floor(px / tile)), tile_y)) {
+                if (moving_down) {
+                    // Land on top of the tile
+                    float surface = (DOWN_Y > 0) ? tile_y * tile : (tile_y + 1) * tile;
+                    py = surface - ITEM_DROP_HALF_SIZE * DOWN_Y;
+                    resting[index] = 1;
+                }
+                vy = 0.0f;
+            } else {
+                py = ny;
+            }
+        }
+    }
+
+    // Horizontal world wrap
+    const float world_width = static_cast<float>(WORLD_WIDTH * TILE_SIZE_PIXELS);
+    if (px < 0.0f) px += world_width;
+    else if (px >= world_width) px -= world_width;
+
+    position_x[index] = px;
+    position_y[index] = py;
+    velocity_x[index] = vx;
+    velocity_y[index] = vy;
+}
+
+void ItemDropSystem::merge_nearby() {
+    const size_t count = item_id.size();
+    if (count < 2) {
+        return;
+    }
+
+    // Bucket table at least twice the drop count (power of two)
+    size_t table_size = 64;
+    while (table_size < count * 2) table_size <<= 1;
+    const size_t mask = table_size - 1;
+    hash_heads.assign(table_size, -1);
+    hash_next.resize(count);
+
+    const float inv_cell = 1.0f / ITEM_DROP_MERGE_RADIUS;
+    const float radius2 = ITEM_DROP_MERGE_RADIUS * ITEM_DROP_MERGE_RADIUS;
+    auto bucket_of = [mask](int cx, int cy) {
+        uint32_t h = static_cast<uint32_t>(cx) * 73856093u ^ static_cast<uint32_t>(cy) * 19349663u;
+        return static_cast<size_t>(h) & mask;
+    };
+
+    for (size_t i = 0; i < count; i++) {
+        int cx = static_cast<int>(std::floor(position_x[i] * inv_cell));
+        int cy = static_cast<int>(std::floor(position_y[i] * inv_cell));
+        bool merged = false;
+
+        // Cell size equals merge radius, so a 3x3 cell search is enough
+        for (int oy = -1; oy <= 1 && !merged; oy++) {
+            for (int ox = -1; ox <= 1 && !merged; ox++) {
+                for (int32_t j = hash_heads[bucket_of(cx + ox, cy + oy)]; j >= 0; j = hash_next[j]) {
+                    if (item_id[j] != item_id[i] ||
+                        stack_count[j] + stack_count[i] > ITEM_DROP_MAX_STACK) {
+                        continue;
+                    }
+                    float dx = position_x[j] - position_x[i];
+                    float dy = position_y[j] - position_y[i];
+                    if (dx * dx + dy * dy > radius2) {
+                        continue;
+                    }
+
+                    stack_count[j] += stack_count[i];
+                    age[j] = std::min(age[j], age[i]);
+                    stack_count[i] = 0;
+                    merged = true;
+                    break;
+                }
+            }
+        }
+
+        if (!merged) {
+            size_t bucket = bucket_of(cx, cy);
+            hash_next[i] = hash_heads[bucket];
+            hash_heads[bucket] = static_cast<int32_t>(i);
+        }
+    }
+
+    // Remove merged drops (stack emptied)
+    for (size_t i = count; i-- > 0;) {
+        if (stack_count[i] == 0) {
+            remove_at(i);
+        }
+    }
+}
+
+void ItemDropSystem::remove_at(size_t index) {
+    size_t last = item_id.size() - 1;
+    if (index != last) {
+        position_x[index] = position_x[last];
+        position_y[index] = position_y[last];
+        velocity_x[index] = velocity_x[last];
+        velocity_y[index] = velocity_y[last];
+        age[index] = age[last];
+        item_id[index] = item_id[last];
+        stack_count[index] = stack_count[last];
+        resting[index] = resting[last];
+    }
+    position_x.pop_back();
+    position_y.pop_back();
+    velocity_x.pop_back();
+    velocity_y.pop_back();
+    age.pop_back();
+    item_id.pop_back();
+    stack_count.pop_back();
+    resting.pop_back();
+}
+
+void ItemDropSystem::rebuild_transform_buffer() {
+    const size_t count = item_id.size();
+    transform_buffer.resize(static_cast<int64_t>(count) * BUFFER_STRIDE);
+    float* dst = transform_buffer.ptrw();
+
+    for (size_t i = 0; i < count; i++) {
+        // Identity basis, origin at drop position
+        dst[0] = 1.0f;  dst[1] = 0.0f;  dst[2] = 0.0f;  dst[3] = position_x[i];
+        dst[4] = 0.0f;  dst[5] = 1.0f;  dst[6] = 0.0f;  dst[7] = position_y[i];
+        // Custom data for the shader (atlas lookup, stack label)
+        dst[8] = static_cast<float>(item_id[i]);
+        dst[9] = static_cast<float>(stack_count[i]);
+        dst[10] = age[i];
+        dst[11] = 0.0f;
+        dst += BUFFER_STRIDE;
+    }
+}
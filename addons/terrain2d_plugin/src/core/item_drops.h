@@ -0,0 +1,103 @@
+#ifndef ITEM_DROPS_H
+#define ITEM_DROPS_H
+
+#include "../world/block_data.h"
+#include "../world/world_constants.h"
+#include "chunk_manager.h"
+#include <godot_cpp/variant/vector2.hpp>
+#include <godot_cpp/variant/vector2i.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
+#include <godot_cpp/variant/packed_int32_array.hpp>
+#include <vector>
+#include <cstdint>
+
+using namespace godot;
+
+// Item drop tuning
+constexpr float ITEM_DROP_HALF_SIZE = 4.0f;      // Half extent of a drop (pixels)
+constexpr float ITEM_DROP_LIFETIME = 300.0f;     // Seconds before a drop despawns
+constexpr float ITEM_DROP_MERGE_RADIUS = 12.0f;  // Same-type drops closer than this merge
+constexpr float ITEM_DROP_MERGE_INTERVAL = 0.25f;// Seconds between merge passes
+constexpr float ITEM_DROP_GROUND_FRICTION = 8.0f;// Horizontal damping while resting
+constexpr uint16_t ITEM_DROP_MAX_STACK = 999;
+
+// Pooled item drops (mined blocks, broken falling blocks)
+// Drops are plain data stored as structure-of-arrays and simulated in one
+// batch; there are no per-drop nodes. Rendering reads one MultiMesh buffer.
+class ItemDropSystem {
+public:
+    // Floats per instance in the transform buffer:
+    // 2D transform (MultiMesh TRANSFORM_2D layout) + custom data (item_id, count, age, 0)
+    static constexpr int BUFFER_STRIDE = 12;
+
+    static constexpr size_t DEFAULT_MAX_DROPS = 8192;
+
+private:
+    ChunkManager* chunk_manager;
+
+    // Drop data (structure of arrays, index = drop)
+    std::vector<float> position_x;
+    std::vector<float> position_y;
+    std::vector<float> velocity_x;
+    std::vector<float> velocity_y;
+    std::vector<float> age;
+    std::vector<uint16_t> item_id;
+    std::vector<uint16_t> stack_count;
+    std::vector<uint8_t> resting;        // On ground (skips gravity integration)
+
+    size_t max_drops;
+    float merge_timer;
+    uint32_t spawn_counter;               // Seeds the spawn scatter
+
+    // Spatial hash for merging (bucket heads + per-drop chains)
+    std::vector<int32_t> hash_heads;
+    std::vector<int32_t> hash_next;
+
+    // MultiMesh-ready instance buffer, rebuilt after each update
+    PackedFloat32Array transform_buffer;
+
+    // Cached chunk for tile collision (drops are spatially coherent)
+    Vector2i cached_chunk_pos;
+    const Chunk2D* cached_chunk;
+
+public:
+    ItemDropSystem(ChunkManager* chunks, size_t max_count = DEFAULT_MAX_DROPS);
+
+    // Spawn a drop at a world position (pixels); returns false if the pool is full
+    bool spawn(Vector2 world_pos, uint16_t id, uint16_t count = 1, Vector2 velocity = Vector2(0, 0));
+
+    // Spawn a drop popping out of a tile
+    bool spawn_at_tile(Vector2i tile_pos, uint16_t id, uint16_t count = 1);
+
+    // Simulate all drops (gravity, tile collision, merging, despawn)
+    void update(float delta_time);
+
+    // Remove drops within radius of a world position
+    // Appends (item_id, count) pairs to out_items, returns number of drops collected
+    int collect(Vector2 world_pos, float radius, PackedInt32Array& out_items);
+
+    // Instance buffer for MultiMesh.set_buffer (BUFFER_STRIDE floats per drop)
+    const PackedFloat32Array& get_transform_buffer() const { return transform_buffer; }
+
+    size_t get_drop_count() const { return item_id.size(); }
+    size_t get_max_drops() const { return max_drops; }
+
+    void clear();
+
+private:
+    // Tile solidity with chunk caching
+    bool is_solid_tile(int tile_x, int tile_y);
+
+    // Move one drop and resolve tile collisions
+    void integrate(size_t index, float delta_time);
+
+    // Merge same-type drops that are close together
+    void merge_nearby();
+
+    // Remove drop by swapping the last one into its slot
+    void remove_at(size_t index);
+
+    void rebuild_transform_buffer();
+};
+
+#endif // ITEM_DROPS_H
@@ -0,0 +1,310 @@
+#include "liquid_reactions.h"
+#include <algorithm>
+#include <tuple>
+
+using namespace godot;
+
+LiquidReactionSystem::LiquidReactionSystem(ChunkManager* chunks, BlockRegistry* registry,
+                                           BiomeSystem* biomes, BlockDamageSystem* damage)
+    : chunk_manager(chunks)
+    , block_registry(registry)
+    , biome_system(biomes)
+    , damage_system(damage)
+    , registry_version(0)
+    , tables_dirty(true)
+    , evaporation_timer(0.0f)
+    , reactions_applied(0)
+{
+    for (int i = 0; i < LIQUID_TYPE_COUNT; i++) {
+        has_block_rules[i] = false;
+        evaporation_rate[i] = 0.0f;
+    }
+}
+
+void LiquidReactionSystem::initialize_default_reactions() {
+    // Lava meeting water cools into obsidian where the lava was
+    uint16_t obsidian = block_registry->get_block_id("obsidian");
+    set_pair_reaction(LAVA, WATER, obsidian, true, MAX_LIQUID_PRESSURE, 0.1f);
+
+    // Acid eats through blocks it can damage (tier and damage reduction still apply)
+    set_default_block_reaction(ACID, 90.0f, 0.02f);
+    if (obsidian != 0) {
+        set_block_reaction(ACID, obsidian, 0.0f, 0.0f);
+    }
+
+    // Shallow water and acid dry up; lava and honey stay
+    set_evaporation_rate(WATER, 0.02f);
+    set_evaporation_rate(ACID, 0.01f);
+}
+
+void LiquidReactionSystem::set_pair_reaction(LiquidType first, LiquidType second, uint16_t product_block,
+                                             bool product_in_first, float consume_first, float consume_second) {
+    if (first == LIQUID_NONE || second == LIQUID_NONE || first == second) {
+        return;
+    }
+
+    LiquidPairReaction& forward = pair_table[first][second];
+    forward.active = true;
+    forward.product_block = product_block;
+    forward.product_in_first = product_in_first;
+    forward.consume_first = consume_first;
+    forward.consume_second = consume_second;
+
+    // Same rule seen from the other liquid
+    LiquidPairReaction& reverse = pair_table[second][first];
+    reverse.active = true;
+    reverse.product_block = product_block;
+    reverse.product_in_first = !product_in_first;
+    reverse.consume_first = consume_second;
+    reverse.consume_second = consume_first;
+}
+
+void LiquidReactionSystem::set_default_block_reaction(LiquidType liquid, float damage, float consume) {
+    default_block_rule[liquid] = LiquidBlockReaction(damage, consume);
+    tables_dirty = true;
+}
+
+void LiquidReactionSystem::set_block_reaction(LiquidType liquid, uint16_t block_type, float damage, float consume) {
+    block_rules[(static_cast<uint32_t>(liquid) << 16) | block_type] = LiquidBlockReaction(damage, consume);
+    tables_dirty = true;
+}
+
+void LiquidReactionSystem::set_evaporation_rate(LiquidType liquid, float level_per_second) {
+    evaporation_rate[liquid] = std::max(level_per_second, 0.0f);
+}
+
+void LiquidReactionSystem::refresh_tables() {
+    if (!tables_dirty && registry_version == block_registry->get_version()) {
+        return;
+    }
+    tables_dirty = false;
+    registry_version = block_registry->get_version();
+
+    const size_t type_count = static_cast<size_t>(block_registry->get_max_block_id()) + 1;
+
+    for (int liquid = 0; liquid < LIQUID_TYPE_COUNT; liquid++) {
+        std::vector<LiquidBlockReaction>& table = block_table[liquid];
+        table.assign(type_count, LiquidBlockReaction());
+        has_block_rules[liquid] = false;
+
+        for (size_t id = 1; id < type_count; id++) {
+            const BlockDefinition* def = block_registry->get_block_definition(static_cast<uint16_t>(id));
+            if (!def) {
+                continue;
+            }
+
+            LiquidBlockReaction rule = default_block_rule[liquid];
+            auto it = block_rules.find((static_cast<uint32_t>(liquid) << 16) | static_cast<uint32_t>(id));
+            if (it != block_rules.end()) {
+                rule = it->second;
+            }
+
+            // Blocks the liquid can't hurt get no entry, so they never produce contacts
+            if (def->required_tool_tier > LIQUID_REACTION_TOOL_TIER || rule.damage <= def->damage_reduction) {
+                continue;
+            }
+
+            table[id] = rule;
+            has_block_rules[liquid] = true;
+        }
+    }
+}
+
+void LiquidReactionSystem::record_liquid_contact(Vector2i tile_pos, uint8_t liquid, Vector2i other_pos, uint8_t other_liquid) {
+    // Both cells see the contact; store it one way round so duplicates collapse
+    LiquidContact contact;
+    bool swap = other_liquid < liquid;
+    contact.liquid_tile = WorldCoords::wrap_tile_x(swap ? other_pos : tile_pos);
+    contact.other_tile = WorldCoords::wrap_tile_x(swap ? tile_pos : other_pos);
+    contact.liquid = swap ? other_liquid : liquid;
+    contact.other_liquid = swap ? liquid : other_liquid;
+    contact.block_type = 0;
+    contacts.push_back(contact);
+}
+
+void LiquidReactionSystem::record_block_contact(Vector2i tile_pos, uint8_t liquid, Vector2i block_pos, uint16_t block_type) {
+    LiquidContact contact;
+    contact.liquid_tile = WorldCoords::wrap_tile_x(tile_pos);
+    contact.other_tile = WorldCoords::wrap_tile_x(block_pos);
+    contact.liquid = liquid;
+    contact.other_liquid = LIQUID_NONE;
+    contact.block_type = block_type;
+    contacts.push_back(contact);
+}
+
+void LiquidReactionSystem::apply_contacts(std::vector<Vector2i>& touched_tiles) {
+    reactions_applied = 0;
+    if (contacts.empty()) {
+        return;
+    }
+
+    // Group by chunk so the chunk lookups and writes stay local
+    auto tile_key = [](Vector2i tile) {
+        Vector2i chunk = WorldCoords::tile_to_chunk(tile);
+        return std::make_tuple(chunk.y, chunk.x, tile.y, tile.x);
+    };
+    std::sort(contacts.begin(), contacts.end(), [&](const LiquidContact& a, const LiquidContact& b) {
+        auto ka = tile_key(a.liquid_tile);
+        auto kb = tile_key(b.liquid_tile);
+        if (ka != kb) return ka < kb;
+        return tile_key(a.other_tile) < tile_key(b.other_tile);
+    });
+    contacts.erase(std::unique(contacts.begin(), contacts.end(), [](const LiquidContact& a, const LiquidContact& b) {
+        return a.liquid_tile == b.liquid_tile && a.other_tile == b.other_tile;
+    }), contacts.end());
+
+    size_t processed = 0;
+    for (; processed < contacts.size() && reactions_applied < LIQUID_MAX_REACTIONS_PER_TICK; processed++) {
+        const LiquidContact& contact = contacts[processed];
+
+        // The liquid step (or an earlier reaction) may have moved things since the contact was seen
+        Chunk2D::LiquidCell cell;
+        if (!chunk_manager->get_liquid_at_tile(contact.liquid_tile, cell) || cell.type != contact.liquid) {
+            continue;
+        }
+
+        if (contact.other_liquid != LIQUID_NONE) {
+            Chunk2D::LiquidCell other;
+            if (!chunk_manager->get_liquid_at_tile(contact.other_tile, other) || other.type != contact.other_liquid) {
+                continue;
+            }
+
+            const LiquidPairReaction& rule = pair_table[contact.liquid][contact.other_liquid];
+            if (!rule.active) {
+                continue;
+            }
+
+            Vector2i product_tile = rule.product_in_first ? contact.liquid_tile : contact.other_tile;
+            Vector2i remaining_tile = rule.product_in_first ? contact.other_tile : contact.liquid_tile;
+            float remaining_consume = rule.product_in_first ? rule.consume_second : rule.consume_first;
+
+            if (rule.product_block != 0) {
+                // The product takes the whole cell
+                chunk_manager->set_liquid_at_tile(product_tile, LIQUID_NONE, 0.0f);
+                Block2D product;
+                product.type_id = rule.product_block;
+                chunk_manager->set_block_at_tile(product_tile, product, false, CAUSE_REACTED);
+                consume_liquid(remaining_tile, remaining_consume);
+            } else {
+                consume_liquid(contact.liquid_tile, rule.consume_first);
+                consume_liquid(contact.other_tile, rule.consume_second);
+            }
+        } else {
+            BlockView block = chunk_manager->get_block_at_tile(contact.other_tile);
+            if (!block || block->type_id != contact.block_type || !damage_system ||
+                !reacts_with_block(contact.liquid, contact.block_type)) {
+                continue;
+            }
+
+            const LiquidBlockReaction& rule = block_table[contact.liquid][contact.block_type];
+            Tool reaction_tool(rule.damage, LIQUID_REACTION_TOOL_TIER, 1.0f);
+            damage_system->damage_block(contact.other_tile, rule.damage, reaction_tool);
+            consume_liquid(contact.liquid_tile, rule.consume);
+        }
+
+        touched_tiles.push_back(contact.liquid_tile);
+        touched_tiles.push_back(contact.other_tile);
+        reactions_applied++;
+    }
+
+    // Contacts over the cap react on the next tick (stale ones fail validation then)
+    contacts.erase(contacts.begin(), contacts.begin() + processed);
+}
+
+void LiquidReactionSystem::update_evaporation(float delta_time, std::vector<Vector2i>& touched_tiles) {
+    evaporation_timer += delta_time;
+    if (evaporation_timer < LIQUID_EVAPORATION_INTERVAL) {
+        return;
+    }
+    const float elapsed = evaporation_timer;
+    evaporation_timer = 0.0f;
+
+    bool any_rate = false;
+    for (int i = 0; i < LIQUID_TYPE_COUNT; i++) {
+        any_rate |= evaporation_rate[i] > 0.0f;
+    }
+    if (!any_rate) {
+        return;
+    }
+
+    const int width = ChunkLiquidGrid::WIDTH;
+    const int height = ChunkLiquidGrid::HEIGHT;
+    float column_rate[ChunkLiquidGrid::WIDTH];
+
+    for (const auto& pair : chunk_manager->get_all_chunks()) {
+        Chunk2D* chunk = pair.second.get();
+        if (!chunk->liquid) {
+            continue;
+        }
+        ChunkLiquidGrid& grid = *chunk->liquid;
+        Vector2i origin(chunk->chunk_position.x * width, chunk->chunk_position.y * height);
+
+        // One biome lookup per column
+        for (int x = 0; x < width; x++) {
+            float biome_rate = 1.0f;
+            if (biome_system) {
+                const BiomeDefinition* biome = biome_system->get_biome_definition(biome_system->get_biome_at(origin.x + x));
+                biome_rate = biome ? biome->evaporation_rate : 1.0f;
+            }
+            column_rate[x] = biome_rate * elapsed;
+        }
+
+        for (int y = 0; y < height; y++) {
+            if (!grid.row_has_liquid(y)) {
+                continue;
+            }
+
+            float* levels = grid.row_levels(y);
+            uint8_t* types = grid.row_types(y);
+            int above_y = y - DOWN_Y;
+
+            for (int x = 0; x < width; x++) {
+                float level = levels[x];
+                if (level <= 0.0f || level > LIQUID_EVAPORATION_MAX_LEVEL || evaporation_rate[types[x]] <= 0.0f) {
+                    continue;
+                }
+
+                // Only the surface evaporates (no liquid directly above)
+                bool covered;
+                if (above_y >= 0 && above_y < height) {
+                    covered = grid.level[above_y * width + x] > 0.0f;
+                } else {
+                    Chunk2D::LiquidCell above;
+                    covered = chunk_manager->get_liquid_at_tile(origin + Vector2i(x, y - DOWN_Y), above);
+                }
+                if (covered) {
+                    continue;
+                }
+
+                level -= evaporation_rate[types[x]] * column_rate[x];
+                if (level < MIN_LIQUID_LEVEL) {
+                    level = 0.0f;
+                    types[x] = LIQUID_NONE;
+                }
+                levels[x] = level;
+                touched_tiles.push_back(origin + Vector2i(x, y));
+                chunk->mark_edited(CHUNK_LAYER_LIQUID, x, y);
+            }
+        }
+    }
+}
+
+void LiquidReactionSystem::clear() {
+    contacts.clear();
+    evaporation_timer = 0.0f;
+    reactions_applied = 0;
+}
+
+void LiquidReactionSystem::consume_liquid(Vector2i tile_pos, float amount) {
+    Chunk2D::LiquidCell cell;
+    if (amount <= 0.0f || !chunk_manager->get_liquid_at_tile(tile_pos, cell)) {
+        return;
+    }
+
+    float level = cell.level - amount;
+    if (level < MIN_LIQUID_LEVEL) {
+        chunk_manager->set_liquid_at_tile(tile_pos, LIQUID_NONE, 0.0f);
+    } else {
+        chunk_manager->set_liquid_at_tile(tile_pos, static_cast<LiquidType>(cell.type), level);
+    }
+}
@@ -0,0 +1,140 @@
+#ifndef LIQUID_REACTIONS_H
+#define LIQUID_REACTIONS_H
+
+#include "../world/block_data.h"
+#include "../world/world_constants.h"
+#include "../world/biome_system.h"
+#include "chunk_manager.h"
+#include "block_registry.h"
+#include "block_damage.h"
+#include <godot_cpp/variant/vector2i.hpp>
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
+
+using namespace godot;
+
+// Reaction tuning
+constexpr float LIQUID_EVAPORATION_INTERVAL = 1.0f;     // Seconds between evaporation passes
+constexpr float LIQUID_EVAPORATION_MAX_LEVEL = 0.3f;    // Only shallow surface cells (puddles) evaporate
+constexpr size_t LIQUID_MAX_REACTIONS_PER_TICK = 1024;  // Remaining contacts react on later ticks
+constexpr int LIQUID_REACTION_TOOL_TIER = 3;            // Blocks needing a better tool resist dissolving
+
+// Two different liquids touching
+struct LiquidPairReaction {
+    bool active;
+    uint16_t product_block;     // Block formed at the contact (0 = liquids are only consumed)
+    bool product_in_first;      // Product replaces the first liquid's cell (else the second's)
+    float consume_first;        // Level removed from the first liquid's cell
+    float consume_second;       // Level removed from the second liquid's cell
+
+    LiquidPairReaction()
+        : active(false)
+        , product_block(0)
+        , product_in_first(true)
+        , consume_first(0.0f)
+        , consume_second(0.0f)
+    {}
+};
+
+// Liquid touching a solid block (dissolution)
+struct LiquidBlockReaction {
+    float damage;               // Raw damage per reaction, applied through BlockDamageSystem (0 = none)
+    float consume;              // Liquid level used up per reaction
+
+    LiquidBlockReaction() : damage(0.0f), consume(0.0f) {}
+    LiquidBlockReaction(float dmg, float used) : damage(dmg), consume(used) {}
+};
+
+// Contact found by the liquid step, resolved in a batch after the step
+struct LiquidContact {
+    Vector2i liquid_tile;
+    Vector2i other_tile;
+    uint8_t liquid;
+    uint8_t other_liquid;       // LIQUID_NONE for liquid-block contacts
+    uint16_t block_type;        // Block at other_tile for liquid-block contacts
+};
+
+// Table-driven liquid reactions
+// Rules are keyed by (liquid, liquid) and (liquid, block type). Block rules are
+// flattened into per-liquid arrays indexed by block type whenever the registry
+// changes, so the liquid kernels test contacts without registry lookups.
+// Contacts are recorded during the liquid step and applied afterwards, sorted
+// by chunk, with at most LIQUID_MAX_REACTIONS_PER_TICK per tick.
+class LiquidReactionSystem {
+private:
+    ChunkManager* chunk_manager;
+    BlockRegistry* block_registry;
+    BiomeSystem* biome_system;          // Optional (evaporation uses rate 1.0 without it)
+    BlockDamageSystem* damage_system;   // Optional (no dissolution without it)
+
+    LiquidPairReaction pair_table[LIQUID_TYPE_COUNT][LIQUID_TYPE_COUNT];
+
+    // Block rules as authored: a default per liquid plus per-type overrides (key = liquid << 16 | type)
+    LiquidBlockReaction default_block_rule[LIQUID_TYPE_COUNT];
+    std::unordered_map<uint32_t, LiquidBlockReaction> block_rules;
+
+    // Flattened block rules, indexed by block type
+    std::vector<LiquidBlockReaction> block_table[LIQUID_TYPE_COUNT];
+    bool has_block_rules[LIQUID_TYPE_COUNT];
+    uint32_t registry_version;
+    bool tables_dirty;
+
+    // Level per second lost by shallow surface cells at biome evaporation_rate 1.0
+    float evaporation_rate[LIQUID_TYPE_COUNT];
+    float evaporation_timer;
+
+    // Contacts recorded this tick (plus ones deferred by the cap)
+    std::vector<LiquidContact> contacts;
+    size_t reactions_applied;
+
+public:
+    LiquidReactionSystem(ChunkManager* chunks, BlockRegistry* registry,
+                         BiomeSystem* biomes = nullptr, BlockDamageSystem* damage = nullptr);
+
+    // Water + lava -> obsidian, acid dissolves blocks, water and acid evaporate
+    void initialize_default_reactions();
+
+    // Rule setup
+    void set_pair_reaction(LiquidType first, LiquidType second, uint16_t product_block,
+                           bool product_in_first, float consume_first, float consume_second);
+    void set_default_block_reaction(LiquidType liquid, float damage, float consume);
+    void set_block_reaction(LiquidType liquid, uint16_t block_type, float damage, float consume);
+    void set_evaporation_rate(LiquidType liquid, float level_per_second);
+
+    // Rebuild the flat block tables if rules or the registry changed
+    void refresh_tables();
+
+    // Contact tests for the liquid kernels (flat table reads)
+    inline bool reacts_with_liquid(uint8_t liquid, uint8_t other) const {
+        return pair_table[liquid][other].active;
+    }
+    inline bool has_block_reactions(uint8_t liquid) const {
+        return has_block_rules[liquid];
+    }
+    inline bool reacts_with_block(uint8_t liquid, uint16_t block_type) const {
+        const std::vector<LiquidBlockReaction>& table = block_table[liquid];
+        return block_type < table.size() && table[block_type].damage > 0.0f;
+    }
+
+    // Record contacts found by the liquid step (tile positions are wrapped here)
+    void record_liquid_contact(Vector2i tile_pos, uint8_t liquid, Vector2i other_pos, uint8_t other_liquid);
+    void record_block_contact(Vector2i tile_pos, uint8_t liquid, Vector2i block_pos, uint16_t block_type);
+    size_t get_pending_contact_count() const { return contacts.size(); }
+    size_t get_reactions_applied() const { return reactions_applied; }
+
+    // Apply recorded contacts (contacts over the per-tick cap stay queued);
+    // appends tiles whose liquid or block changed so the caller can wake them
+    void apply_contacts(std::vector<Vector2i>& touched_tiles);
+
+    // Shallow surface liquid evaporates, scaled by BiomeDefinition::evaporation_rate
+    void update_evaporation(float delta_time, std::vector<Vector2i>& touched_tiles);
+
+    void clear();
+
+private:
+    // Remove level from a liquid cell (drops it below MIN_LIQUID_LEVEL to nothing)
+    void consume_liquid(Vector2i tile_pos, float amount);
+};
+
+#endif // LIQUID_REACTIONS_H
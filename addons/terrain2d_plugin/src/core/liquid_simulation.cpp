@@ -0,0 +1,568 @@
+#include "liquid_simulation.h"
+#include <algorithm>
+#include <bitset>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+using namespace godot;
+
+// Liquid can occupy air, liquid blocks and platforms
+static inline bool is_open_block(const Block2D& block) {
+    return block.type_id == 0 ||
+           block.has_flag(Block2D::IS_LIQUID) ||
+           block.has_flag(Block2D::IS_PLATFORM);
+}
+
+// Open tiles of row y of a block layer (bit x = column x)
+static inline uint32_t open_row(const ChunkBlockPlane& plane, int y) {
+    return plane.get_type_row(y, 0) | plane.get_flag_row(y, Block2D::IS_LIQUID | Block2D::IS_PLATFORM);
+}
+
+// Level the lower of two stacked cells holds at rest, given their combined level
+static inline float stable_lower_level(float total) {
+    float compressed = (MAX_LIQUID_LEVEL * MAX_LIQUID_LEVEL + total * LIQUID_MAX_COMPRESSION) /
+                       (MAX_LIQUID_LEVEL + LIQUID_MAX_COMPRESSION);
+    float saturated = (total + LIQUID_MAX_COMPRESSION) * 0.5f;
+    float over = total < 2.0f * MAX_LIQUID_LEVEL + LIQUID_MAX_COMPRESSION ? compressed : saturated;
+    return total <= MAX_LIQUID_LEVEL ? total : over;
+}
+
+// Block type in a lane of a row view (0 where the chunk isn't loaded)
+static inline uint16_t lane_block_type(Chunk2D* const chunks[3], int lane, int local_y) {
+    const int last = ChunkLiquidGrid::WIDTH + 1;
+    const Chunk2D* chunk = chunks[lane == 0 ? 0 : (lane == last ? 2 : 1)];
+    int x = lane == 0 ? ChunkLiquidGrid::WIDTH - 1 : (lane == last ? 0 : lane - 1);
+    return chunk ? chunk->foreground.get_type(x, local_y) : 0;
+}
+
+LiquidSystem::LiquidSystem(ChunkManager* chunks, LiquidReactionSystem* reaction_system)
+    : chunk_manager(chunks)
+    , reactions(reaction_system)
+    , tick_accumulator(0.0f)
+{}
+
+void LiquidSystem::update(float delta_time) {
+    const float tick_interval = 1.0f / LIQUID_TICK_RATE;
+    tick_accumulator += delta_time;
+
+    int ticks = 0;
+    while (tick_accumulator >= tick_interval && ticks < LIQUID_MAX_TICKS_PER_FRAME) {
+        tick();
+        tick_accumulator -= tick_interval;
+        ticks++;
+    }
+
+    // Fell behind - drop the backlog rather than catching up over several frames
+    if (tick_accumulator >= tick_interval) {
+        tick_accumulator = 0.0f;
+    }
+
+    if (reactions) {
+        reaction_tiles.clear();
+        reactions->update_evaporation(delta_time, reaction_tiles);
+        wake_reaction_tiles();
+    }
+}
+
+void LiquidSystem::tick() {
+    auto start = std::chrono::steady_clock::now();
+
+    if (reactions) {
+        reactions->refresh_tables();
+    }
+
+    // Rows woken during this tick go into the (now empty) active set
+    stepping_rows.swap(active_rows);
+    stats.active_rows = 0;
+    stats.active_chunks = 0;
+
+    // Bottom chunks first (DOWN_Y decides which end) so liquid falls through a whole column in one tick
+    chunk_order.clear();
+    for (const auto& pair : stepping_rows) {
+        chunk_order.push_back(pair.first);
+    }
+    std::sort(chunk_order.begin(), chunk_order.end(), [](const Vector2i& a, const Vector2i& b) {
+        return a.y != b.y ? a.y * DOWN_Y > b.y * DOWN_Y : a.x < b.x;
+    });
+
+    stats.rows_stepped = 0;
+    stats.cells_changed = 0;
+
+    for (const Vector2i& chunk_pos : chunk_order) {
+        uint32_t rows = stepping_rows[chunk_pos];
+
+        Chunk2D* center = chunk_manager->get_chunk(chunk_pos);
+        if (!center) {
+            continue;
+        }
+
+        Chunk2D* around[3][3];
+        for (int dy = -1; dy <= 1; dy++) {
+            for (int dx = -1; dx <= 1; dx++) {
+                around[dy + 1][dx + 1] = center->get_neighbor(dx, dy);
+            }
+        }
+
+        // Bottom rows first within the chunk
+        for (int i = 0; i < ChunkLiquidGrid::HEIGHT; i++) {
+            int y = DOWN_Y > 0 ? ChunkLiquidGrid::HEIGHT - 1 - i : i;
+            if (!(rows & (1u << y))) {
+                continue;
+            }
+
+            // Rows without liquid have nothing to move; liquid flowing into
+            // them is handled by the row it comes from
+            if (!center->liquid || !center->liquid->row_has_liquid(y)) {
+                continue;
+            }
+
+            step_row(around, chunk_pos, y);
+            stats.rows_stepped++;
+        }
+
+        if (center->liquid && center->liquid->is_empty()) {
+            center->release_liquid_grid();
+        }
+    }
+
+    stepping_rows.clear();
+
+    // Reactions found while stepping are applied together, after all flow
+    if (reactions) {
+        reaction_tiles.clear();
+        reactions->apply_contacts(reaction_tiles);
+        wake_reaction_tiles();
+    }
+
+    stats.total_ticks++;
+    stats.tick_usec = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count());
+}
+
+bool LiquidSystem::add_liquid(Vector2i tile_pos, LiquidType type, float amount) {
+    tile_pos = WorldCoords::wrap_tile_x(tile_pos);
+    if (!WorldCoords::is_valid_y(tile_pos.y) || type == LIQUID_NONE || amount <= 0.0f) {
+        return false;
+    }
+
+    Chunk2D* chunk = chunk_manager->get_chunk(WorldCoords::tile_to_chunk(tile_pos));
+    if (!chunk) {
+        return false;
+    }
+
+    Vector2i local_pos = WorldCoords::tile_to_local(tile_pos);
+    if (!is_open_block(*chunk->get_block(local_pos))) {
+        return false;
+    }
+
+    Chunk2D::LiquidCell cell;
+    bool has_liquid = chunk->get_liquid(local_pos, cell);
+    if (has_liquid && cell.type != type) {
+        return false;
+    }
+
+    float level = (has_liquid ? cell.level : 0.0f) + amount;
+    chunk->set_liquid(local_pos, type, std::min(level, MAX_LIQUID_PRESSURE));
+    if (!has_liquid) {
+        cell_changes.push_back({ tile_pos, static_cast<uint8_t>(type) });
+    }
+    queue_tile(tile_pos);
+    return true;
+}
+
+void LiquidSystem::remove_liquid(Vector2i tile_pos) {
+    Chunk2D::LiquidCell cell;
+    if (chunk_manager->get_liquid_at_tile(tile_pos, cell)) {
+        cell_changes.push_back({ tile_pos, static_cast<uint8_t>(cell.type) });
+    }
+    chunk_manager->set_liquid_at_tile(tile_pos, LIQUID_NONE, 0.0f);
+    queue_tile(tile_pos);
+}
+
+float LiquidSystem::get_liquid_level(Vector2i tile_pos) const {
+    Chunk2D::LiquidCell cell;
+    return chunk_manager->get_liquid_at_tile(tile_pos, cell) ? cell.level : 0.0f;
+}
+
+void LiquidSystem::wake_tile(Vector2i tile_pos) {
+    queue_tile(tile_pos);
+}
+
+void LiquidSystem::wake_chunk(Vector2i chunk_pos) {
+    Chunk2D* chunk = chunk_manager->get_chunk(chunk_pos);
+    if (!chunk || !chunk->liquid) {
+        return;
+    }
+
+    for (int y = 0; y < ChunkLiquidGrid::HEIGHT; y++) {
+        if (chunk->liquid->row_has_liquid(y)) {
+            queue_row(chunk->chunk_position, y);
+        }
+    }
+}
+
+void LiquidSystem::wake_from_events(const BlockChangeEvent* events, size_t count) {
+    if (count == 0) {
+        return;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        if (!events[i].is_background) {
+            queue_tile(events[i].get_tile_pos());
+        }
+    }
+}
+
+void LiquidSystem::clear() {
+    active_rows.clear();
+    stepping_rows.clear();
+    tick_accumulator = 0.0f;
+    stats = LiquidStats();
+    cell_changes.clear();
+    if (reactions) {
+        reactions->clear();
+    }
+}
+
+void LiquidSystem::queue_row(Vector2i chunk_pos, int local_y) {
+    if (local_y < 0) {
+        chunk_pos.y -= 1;
+        local_y += ChunkLiquidGrid::HEIGHT;
+    } else if (local_y >= ChunkLiquidGrid::HEIGHT) {
+        chunk_pos.y += 1;
+        local_y -= ChunkLiquidGrid::HEIGHT;
+    }
+
+    if (!WorldCoords::is_valid_y(chunk_pos.y * ChunkLiquidGrid::HEIGHT + local_y)) {
+        return;
+    }
+
+    chunk_pos = WorldCoords::wrap_chunk_x(chunk_pos);
+    uint32_t& rows = active_rows[chunk_pos];
+    const uint32_t bit = 1u << local_y;
+    if (!(rows & bit)) {
+        // Counted here so the stats never need a walk over the active set
+        stats.active_chunks += rows == 0;
+        stats.active_rows++;
+        rows |= bit;
+    }
+}
+
+void LiquidSystem::queue_tile(Vector2i tile_pos) {
+    tile_pos = WorldCoords::wrap_tile_x(tile_pos);
+    if (!WorldCoords::is_valid_y(tile_pos.y)) {
+        return;
+    }
+
+    Vector2i chunk_pos = WorldCoords::tile_to_chunk(tile_pos);
+    Vector2i local_pos = WorldCoords::tile_to_local(tile_pos);
+
+    for (int dy = -1; dy <= 1; dy++) {
+        queue_row(chunk_pos, local_pos.y + dy);
+        if (local_pos.x == 0) {
+            queue_row(chunk_pos + Vector2i(-1, 0), local_pos.y + dy);
+        } else if (local_pos.x == ChunkLiquidGrid::WIDTH - 1) {
+            queue_row(chunk_pos + Vector2i(1, 0), local_pos.y + dy);
+        }
+    }
+}
+
+void LiquidSystem::step_row(Chunk2D* const around[3][3], Vector2i chunk_pos, int local_y) {
+    load_row(current_view, around, chunk_pos, local_y);
+    load_row(below_view, around, chunk_pos, local_y + DOWN_Y);
+    load_row(above_view, around, chunk_pos, local_y - DOWN_Y);
+
+    // Liquid displaced by a placed block is lost
+    for (int i = 1; i <= ROW_WIDTH; i++) {
+        current_view.level[i] = current_view.open[i] ? current_view.level[i] : 0.0f;
+    }
+
+    flow_down(current_view, below_view);
+    flow_sideways(current_view);
+    flow_up(current_view, above_view);
+    settle_droplets(current_view, below_view);
+    if (reactions) {
+        collect_contacts(current_view, below_view, above_view);
+    }
+
+    RowView* views[3] = { &below_view, &current_view, &above_view };
+    for (RowView* view : views) {
+        bool left_changed = false;
+        bool right_changed = false;
+        uint32_t changed = store_row(*view, left_changed, right_changed);
+        stats.cells_changed += std::bitset<32>(changed).count() + left_changed + right_changed;
+        queue_changes(*view, changed, left_changed, right_changed);
+    }
+}
+
+void LiquidSystem::load_row(RowView& view, Chunk2D* const around[3][3], Vector2i chunk_pos, int local_y) {
+    // Rows past the chunk edge come from the chunk above/below
+    int dy = 0;
+    if (local_y < 0) {
+        dy = -1;
+        local_y += ChunkLiquidGrid::HEIGHT;
+    } else if (local_y >= ChunkLiquidGrid::HEIGHT) {
+        dy = 1;
+        local_y -= ChunkLiquidGrid::HEIGHT;
+    }
+
+    Chunk2D* const* row_chunks = around[dy + 1];
+    view.chunks[0] = row_chunks[0];
+    view.chunks[1] = row_chunks[1];
+    view.chunks[2] = row_chunks[2];
+    view.chunk_pos = Vector2i(chunk_pos.x, chunk_pos.y + dy);
+    view.local_y = local_y;
+
+    // Center cells
+    const Chunk2D* center = row_chunks[1];
+    if (center && center->liquid) {
+        std::memcpy(view.level + 1, center->liquid->row_levels(local_y), ROW_WIDTH * sizeof(float));
+        std::memcpy(view.type + 1, center->liquid->row_types(local_y), ROW_WIDTH);
+    } else {
+        std::fill(view.level + 1, view.level + 1 + ROW_WIDTH, 0.0f);
+        std::fill(view.type + 1, view.type + 1 + ROW_WIDTH, static_cast<uint8_t>(LIQUID_NONE));
+    }
+    const uint32_t open = center ? open_row(center->foreground, local_y) : 0;
+    for (int x = 0; x < ROW_WIDTH; x++) {
+        view.open[x + 1] = (open >> x) & 1u;
+    }
+
+    // Edge cells of the side chunks
+    const int edges[2] = { 0, ROW_SPAN - 1 };
+    const int edge_x[2] = { ChunkLiquidGrid::WIDTH - 1, 0 };
+    for (int side = 0; side < 2; side++) {
+        const Chunk2D* chunk = row_chunks[side * 2];
+        int lane = edges[side];
+        int x = edge_x[side];
+        int index = local_y * ChunkLiquidGrid::WIDTH + x;
+
+        view.level[lane] = (chunk && chunk->liquid) ? chunk->liquid->level[index] : 0.0f;
+        view.type[lane] = (chunk && chunk->liquid) ? chunk->liquid->type[index] : static_cast<uint8_t>(LIQUID_NONE);
+        view.open[lane] = chunk && is_open_block(chunk->foreground.get(x, local_y));
+    }
+
+    std::memcpy(view.before, view.level, sizeof(view.level));
+}
+
+uint32_t LiquidSystem::store_row(RowView& view, bool& left_changed, bool& right_changed) {
+    uint32_t changed = 0;
+    uint32_t flipped = 0;
+    bool any_liquid = false;
+    for (int x = 0; x < ROW_WIDTH; x++) {
+        bool has_liquid = view.level[x + 1] > 0.0f;
+        changed |= static_cast<uint32_t>(view.level[x + 1] != view.before[x + 1]) << x;
+        flipped |= static_cast<uint32_t>(has_liquid != (view.before[x + 1] > 0.0f)) << x;
+        any_liquid |= has_liquid;
+    }
+
+    // Filled / drained cells (types stay set in the view when a cell drains)
+    const Vector2i row_origin(view.chunk_pos.x * ROW_WIDTH, view.chunk_pos.y * ChunkLiquidGrid::HEIGHT + view.local_y);
+    for (int x = 0; x < ROW_WIDTH && (flipped >> x); x++) {
+        if (flipped & (1u << x)) {
+            cell_changes.push_back({ row_origin + Vector2i(x, 0), view.type[x + 1] });
+        }
+    }
+
+    Chunk2D* center = view.chunks[1];
+    if (changed && center && (center->liquid || any_liquid)) {
+        ChunkLiquidGrid& grid = center->ensure_liquid_grid();
+        float* levels = grid.row_levels(view.local_y);
+        uint8_t* types = grid.row_types(view.local_y);
+        for (int x = 0; x < ROW_WIDTH; x++) {
+            levels[x] = view.level[x + 1];
+            types[x] = view.level[x + 1] > 0.0f ? view.type[x + 1] : static_cast<uint8_t>(LIQUID_NONE);
+        }
+        center->mark_edited(CHUNK_LAYER_LIQUID, 0, view.local_y, ROW_WIDTH - 1, view.local_y);
+    }
+
+    // Edge cells written back into the side chunks
+    left_changed = view.level[0] != view.before[0];
+    right_changed = view.level[ROW_SPAN - 1] != view.before[ROW_SPAN - 1];
+    if ((view.level[0] > 0.0f) != (view.before[0] > 0.0f)) {
+        cell_changes.push_back({ row_origin + Vector2i(-1, 0), view.type[0] });
+    }
+    if ((view.level[ROW_SPAN - 1] > 0.0f) != (view.before[ROW_SPAN - 1] > 0.0f)) {
+        cell_changes.push_back({ row_origin + Vector2i(ROW_WIDTH, 0), view.type[ROW_SPAN - 1] });
+    }
+
+    if (left_changed && view.chunks[0]) {
+        view.chunks[0]->set_liquid(Vector2i(ChunkLiquidGrid::WIDTH - 1, view.local_y),
+                                   static_cast<LiquidType>(view.type[0]), view.level[0]);
+    }
+    if (right_changed && view.chunks[2]) {
+        view.chunks[2]->set_liquid(Vector2i(0, view.local_y),
+                                   static_cast<LiquidType>(view.type[ROW_SPAN - 1]), view.level[ROW_SPAN - 1]);
+    }
+
+    return changed;
+}
+
+void LiquidSystem::queue_changes(const RowView& view, uint32_t changed, bool left_changed, bool right_changed) {
+    // A changed cell keeps its own row and the rows it can flow into awake
+    auto queue_around = [this](Vector2i chunk_pos, int y) {
+        queue_row(chunk_pos, y - 1);
+        queue_row(chunk_pos, y);
+        queue_row(chunk_pos, y + 1);
+    };
+
+    if (changed) {
+        queue_around(view.chunk_pos, view.local_y);
+    }
+    if (left_changed || (changed & 1u)) {
+        queue_around(view.chunk_pos + Vector2i(-1, 0), view.local_y);
+    }
+    if (right_changed || (changed & (1u << (ROW_WIDTH - 1)))) {
+        queue_around(view.chunk_pos + Vector2i(1, 0), view.local_y);
+    }
+}
+
+void LiquidSystem::flow_down(RowView& source, RowView& target) {
+    // Fill the cell below up to its stable (slightly compressed) level
+    for (int i = 1; i <= ROW_WIDTH; i++) {
+        float src = source.level[i];
+        float dst = target.level[i];
+        bool compatible = target.open[i] && (target.type[i] == source.type[i] || dst <= 0.0f);
+
+        float flow = std::min(std::max(stable_lower_level(src + dst) - dst, 0.0f), std::min(LIQUID_MAX_FLOW, src));
+        flow = (compatible && (flow >= LIQUID_MIN_FLOW || flow >= src)) ? flow : 0.0f;
+
+        source.level[i] = src - flow;
+        target.level[i] = dst + flow;
+        target.type[i] = flow > 0.0f ? source.type[i] : target.type[i];
+    }
+}
+
+void LiquidSystem::flow_up(RowView& source, RowView& target) {
+    // Pressure pushes the excess above a full cell up (never starting a droplet)
+    for (int i = 1; i <= ROW_WIDTH; i++) {
+        float src = source.level[i];
+        float dst = target.level[i];
+        bool compatible = target.open[i] && (target.type[i] == source.type[i] || dst <= 0.0f);
+
+        float flow = std::min(std::max(src - stable_lower_level(src + dst), 0.0f), std::min(LIQUID_MAX_FLOW, src));
+        bool keep = compatible && src > MAX_LIQUID_LEVEL && flow >= LIQUID_MIN_FLOW &&
+                    (dst > 0.0f || flow >= MIN_LIQUID_LEVEL);
+        flow = keep ? flow : 0.0f;
+
+        source.level[i] = src - flow;
+        target.level[i] = dst + flow;
+        target.type[i] = flow > 0.0f ? source.type[i] : target.type[i];
+    }
+}
+
+void LiquidSystem::flow_sideways(RowView& row) {
+    // Pair p sits between cells p and p + 1; positive flow moves right.
+    // Flows are computed from the same snapshot (Jacobi) so every lane is independent.
+    for (int p = 0; p < ROW_SPAN - 1; p++) {
+        float a = row.level[p];
+        float b = row.level[p + 1];
+        bool compatible = row.open[p] && row.open[p + 1] &&
+                          (row.type[p] == row.type[p + 1] || a <= 0.0f || b <= 0.0f);
+
+        float flow = (a - b) * LIQUID_SIDE_FLOW;
+        float magnitude = std::fabs(flow);
+        float receiver = flow > 0.0f ? b : a;
+        bool keep = compatible && magnitude >= LIQUID_MIN_FLOW &&
+                    (receiver > 0.0f || magnitude >= MIN_LIQUID_LEVEL);
+        pair_flow[p] = keep ? flow : 0.0f;
+    }
+    pair_flow[ROW_SPAN - 1] = 0.0f;
+
+    // An empty cell can't be filled by two different liquids at once
+    for (int i = 1; i <= ROW_WIDTH; i++) {
+        bool conflict = row.level[i] <= 0.0f && pair_flow[i - 1] > 0.0f && pair_flow[i] < 0.0f &&
+                        row.type[i - 1] != row.type[i + 1];
+        pair_flow[i] = conflict ? 0.0f : pair_flow[i];
+    }
+
+    // Side chunk edge cells (only their pair with this row)
+    const int last = ROW_SPAN - 1;
+    if (row.level[0] <= 0.0f && pair_flow[0] < 0.0f) {
+        row.type[0] = row.type[1];
+    }
+    if (row.level[last] <= 0.0f && pair_flow[last - 1] > 0.0f) {
+        row.type[last] = row.type[last - 1];
+    }
+    row.level[0] -= pair_flow[0];
+    row.level[last] += pair_flow[last - 1];
+
+    // Apply; empty cells take the type of the liquid flowing in
+    for (int i = 1; i <= ROW_WIDTH; i++) {
+        float was = row.level[i];
+        uint8_t incoming = pair_flow[i - 1] > 0.0f ? row.type[i - 1] : row.type[i + 1];
+        row.level[i] = was + pair_flow[i - 1] - pair_flow[i];
+        row.type[i] = was <= 0.0f ? incoming : row.type[i];
+    }
+}
+
+void LiquidSystem::settle_droplets(RowView& row, RowView& below) {
+    for (int i = 1; i <= ROW_WIDTH; i++) {
+        float level = row.level[i];
+        if (!(level > 0.0f && level < MIN_LIQUID_LEVEL && level == row.before[i])) {
+            continue;
+        }
+
+        // Join a neighboring cell of the same liquid, evaporate only when alone
+        uint8_t type = row.type[i];
+        if (below.open[i] && below.level[i] > 0.0f && below.type[i] == type) {
+            below.level[i] += level;
+        } else if (row.open[i - 1] && row.level[i - 1] > 0.0f && row.type[i - 1] == type) {
+            row.level[i - 1] += level;
+        } else if (row.open[i + 1] && row.level[i + 1] > 0.0f && row.type[i + 1] == type) {
+            row.level[i + 1] += level;
+        }
+        row.level[i] = 0.0f;
+    }
+}
+
+void LiquidSystem::collect_contacts(const RowView& row, const RowView& below, const RowView& above) {
+    const Vector2i origin(row.chunk_pos.x * ROW_WIDTH - 1, row.chunk_pos.y * ChunkLiquidGrid::HEIGHT + row.local_y);
+
+    for (int i = 1; i <= ROW_WIDTH; i++) {
+        float level = row.level[i];
+        uint8_t type = row.type[i];
+        if (level <= 0.0f) {
+            continue;
+        }
+        Vector2i tile_pos = origin + Vector2i(i, 0);
+
+        // Different liquids side by side or stacked
+        const RowView* views[4] = { &row, &row, &below, &above };
+        const int lanes[4] = { i - 1, i + 1, i, i };
+        const int offsets_y[4] = { 0, 0, DOWN_Y, -DOWN_Y };
+        for (int n = 0; n < 4; n++) {
+            const RowView& view = *views[n];
+            int lane = lanes[n];
+            uint8_t other = view.type[lane];
+            if (view.level[lane] > 0.0f && other != type && reactions->reacts_with_liquid(type, other)) {
+                reactions->record_liquid_contact(tile_pos, type, tile_pos + Vector2i(lane - i, offsets_y[n]), other);
+            }
+        }
+
+        // Solid neighbors the liquid dissolves (table lookup by block type)
+        if (!reactions->has_block_reactions(type)) {
+            continue;
+        }
+        for (int n = 0; n < 4; n++) {
+            const RowView& view = *views[n];
+            int lane = lanes[n];
+            if (view.open[lane]) {
+                continue;
+            }
+            uint16_t block_type = lane_block_type(view.chunks, lane, view.local_y);
+            if (reactions->reacts_with_block(type, block_type)) {
+                reactions->record_block_contact(tile_pos, type, tile_pos + Vector2i(lane - i, offsets_y[n]), block_type);
+            }
+        }
+    }
+}
+
+void LiquidSystem::wake_reaction_tiles() {
+    if (reaction_tiles.empty()) {
+        return;
+    }
+    for (const Vector2i& tile_pos : reaction_tiles) {
+        queue_tile(tile_pos);
+    }
+}
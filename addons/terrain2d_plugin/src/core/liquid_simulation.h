@@ -0,0 +1,160 @@
+#ifndef LIQUID_SIMULATION_H
+#define LIQUID_SIMULATION_H
+
+#include "../world/block_data.h"
+#include "../world/world_constants.h"
+#include "../world/chunk_2d.h"
+#include "../world/chunk_liquid.h"
+#include "chunk_manager.h"
+#include "block_events.h"
+#include "liquid_reactions.h"
+#include <godot_cpp/variant/vector2i.hpp>
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
+
+using namespace godot;
+
+// Liquid simulation tuning
+constexpr float LIQUID_TICK_RATE = 30.0f;          // Fixed simulation rate (ticks per second)
+constexpr int LIQUID_MAX_TICKS_PER_FRAME = 2;      // Drop ticks instead of spiralling on slow frames
+constexpr float LIQUID_MAX_COMPRESSION = 0.1f;     // Extra level a cell holds per full cell above it
+constexpr float LIQUID_SIDE_FLOW = 0.4f;           // Share of the level difference moved between side neighbors (< 0.5 stays stable)
+constexpr float LIQUID_MIN_FLOW = 0.002f;          // Smaller flows are ignored so bodies can settle
+constexpr float LIQUID_MAX_FLOW = 1.0f;            // Max level moved between two cells per tick
+
+// Counters from the last liquid tick (for debug overlays and profiling)
+struct LiquidStats {
+    size_t active_rows;       // Chunk rows (32 cells) queued for the next tick
+    size_t active_chunks;     // Chunks with at least one queued row
+    size_t rows_stepped;      // Rows run through the flow kernels by the last tick
+    size_t cells_changed;     // Cells whose level changed in the last tick
+    uint64_t tick_usec;       // Duration of the last tick
+    uint64_t total_ticks;
+
+    LiquidStats()
+        : active_rows(0)
+        , active_chunks(0)
+        , rows_stepped(0)
+        , cells_changed(0)
+        , tick_usec(0)
+        , total_ticks(0)
+    {}
+};
+
+// A cell that filled or drained (lighting follows these for glowing liquids)
+struct LiquidCellChange {
+    Vector2i tile_pos;          // Unwrapped X at chunk edges
+    uint8_t type;               // Liquid that appeared or disappeared
+};
+
+// Pressure-based liquid flow (Starbound-style)
+// Liquid lives in each chunk's dense ChunkLiquidGrid. The solver steps whole
+// chunk rows: a row is loaded (padded with the edge cells of the side chunks),
+// run through branch-free down / sideways / up kernels against the rows below
+// and above it (toward and away from DOWN_Y), and written back. Only queued rows are stepped; a row whose
+// cells don't change falls asleep, so still lakes and oceans cost nothing
+// until a neighboring block changes.
+class LiquidSystem {
+public:
+    static constexpr int ROW_WIDTH = ChunkLiquidGrid::WIDTH;
+    static constexpr int ROW_SPAN = ROW_WIDTH + 2;   // Row plus the neighboring cell on each side
+
+private:
+    // One chunk row padded with the edge cells of the chunks left and right of it
+    // (index 0 = left chunk x=31, 1..32 = this row, 33 = right chunk x=0)
+    struct RowView {
+        alignas(32) float level[ROW_SPAN];
+        alignas(32) float before[ROW_SPAN];  // Levels when loaded (change detection)
+        uint8_t type[ROW_SPAN];
+        uint8_t open[ROW_SPAN];              // 1 where liquid may be (loaded, not solid)
+        Chunk2D* chunks[3];                  // Left, center, right (nullptr if unloaded)
+        Vector2i chunk_pos;                  // Center chunk
+        int local_y;
+    };
+
+    ChunkManager* chunk_manager;
+    LiquidReactionSystem* reactions;    // Optional (liquids don't react without it)
+
+    // Queued rows per chunk (bit y = row y), for the next tick and the one being stepped
+    std::unordered_map<Vector2i, uint32_t, Vector2iHash> active_rows;
+    std::unordered_map<Vector2i, uint32_t, Vector2iHash> stepping_rows;
+    std::vector<Vector2i> chunk_order;
+
+    // Kernel scratch
+    RowView above_view;
+    RowView current_view;
+    RowView below_view;
+    alignas(32) float pair_flow[ROW_SPAN];
+    std::vector<Vector2i> reaction_tiles;
+
+    float tick_accumulator;
+    LiquidStats stats;
+
+    // Cells that filled or drained since the last clear_cell_changes()
+    std::vector<LiquidCellChange> cell_changes;
+
+public:
+    LiquidSystem(ChunkManager* chunks, LiquidReactionSystem* reaction_system = nullptr);
+
+    // Advance the simulation at LIQUID_TICK_RATE
+    void update(float delta_time);
+
+    // Run one simulation tick
+    void tick();
+
+    // Add liquid to a tile (mixing types is not allowed, returns false if blocked)
+    bool add_liquid(Vector2i tile_pos, LiquidType type, float amount);
+    void remove_liquid(Vector2i tile_pos);
+    float get_liquid_level(Vector2i tile_pos) const;
+
+    // Wake liquid (queue rows for the next tick)
+    void wake_tile(Vector2i tile_pos);
+    void wake_chunk(Vector2i chunk_pos);
+
+    // Wake liquid around every changed block (call with the published frame events)
+    void wake_from_events(const BlockChangeEvent* events, size_t count);
+
+    // Filled / drained cells (the consumer clears them once per frame)
+    const std::vector<LiquidCellChange>& get_cell_changes() const { return cell_changes; }
+    void clear_cell_changes() { cell_changes.clear(); }
+
+    const LiquidStats& get_stats() const { return stats; }
+    size_t get_active_row_count() const { return stats.active_rows; }
+
+    void clear();
+
+private:
+    // Queue a row (local_y outside the chunk moves to the chunk above/below)
+    void queue_row(Vector2i chunk_pos, int local_y);
+
+    // Queue the rows around a tile, plus the side chunk's rows at chunk edges
+    void queue_tile(Vector2i tile_pos);
+
+    // Run one row of a chunk through the flow kernels
+    // around[dy][dx] holds the chunk at offset (dx - 1, dy - 1)
+    void step_row(Chunk2D* const around[3][3], Vector2i chunk_pos, int local_y);
+
+    // Load / store a padded row; store returns the changed mask of the center cells
+    void load_row(RowView& view, Chunk2D* const around[3][3], Vector2i chunk_pos, int local_y);
+    uint32_t store_row(RowView& view, bool& left_changed, bool& right_changed);
+
+    // Queue rows touched by a stored row
+    void queue_changes(const RowView& view, uint32_t changed, bool left_changed, bool right_changed);
+
+    // Flow kernels (lanes 1..ROW_WIDTH of the views)
+    static void flow_down(RowView& source, RowView& target);
+    static void flow_up(RowView& source, RowView& target);
+    void flow_sideways(RowView& row);
+
+    // Droplets below MIN_LIQUID_LEVEL that couldn't move merge into a neighbor or evaporate
+    static void settle_droplets(RowView& row, RowView& below);
+
+    // Record reacting contacts of a stepped row (applied in a batch after the tick)
+    void collect_contacts(const RowView& row, const RowView& below, const RowView& above);
+
+    // Wake the liquid around tiles changed by reactions or evaporation
+    void wake_reaction_tiles();
+};
+
+#endif // LIQUID_SIMULATION_H
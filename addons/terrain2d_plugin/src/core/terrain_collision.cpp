@@ -0,0 +1,205 @@
+#include "terrain_collision.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+
+using namespace godot;
+
+// Index of the lowest set bit (mask != 0)
+static inline int lowest_bit(uint32_t mask) {
+    int index = 0;
+    while ((mask & 1u) == 0) {
+        mask >>= 1;
+        index++;
+    }
+    return index;
+}
+
+// Bits of the run of set bits starting at `start`
+static inline uint32_t run_at(uint32_t mask, int start) {
+    uint32_t run = 0;
+    for (int x = start; x < CHUNK_WIDTH && ((mask >> x) & 1u); x++) {
+        run |= 1u << x;
+    }
+    return run;
+}
+
+TerrainCollisionSystem::TerrainCollisionSystem(ChunkManager* chunks)
+    : chunk_manager(chunks)
+    , collision_revision(chunks->get_collision_revision())
+    , focus_chunk(0, 0)
+    , radius(COLLISION_CHUNK_RADIUS_X, COLLISION_CHUNK_RADIUS_Y)
+{}
+
+void TerrainCollisionSystem::update() {
+    auto start = std::chrono::steady_clock::now();
+    stats.chunks_rebuilt = 0;
+    stats.rects_rebuilt = 0;
+
+    // Solidity changed under already built chunks
+    if (collision_revision != chunk_manager->get_collision_revision()) {
+        collision_revision = chunk_manager->get_collision_revision();
+        invalidate_all();
+    }
+
+    // Chunks that left the radius (or were unloaded) give their buffers back
+    for (auto it = shapes.begin(); it != shapes.end();) {
+        const Vector2i offset = it->first - focus_chunk;
+        if (std::abs(offset.x) <= radius.x && std::abs(offset.y) <= radius.y && chunk_manager->get_chunk(it->first)) {
+            ++it;
+            continue;
+        }
+        updated_chunks.erase(std::remove(updated_chunks.begin(), updated_chunks.end(), it->first), updated_chunks.end());
+        released_chunks.push_back(it->first);
+        spare_shapes.push_back(std::move(it->second));
+        it = shapes.erase(it);
+    }
+
+    for (int cy = focus_chunk.y - radius.y; cy <= focus_chunk.y + radius.y; cy++) {
+        for (int cx = focus_chunk.x - radius.x; cx <= focus_chunk.x + radius.x; cx++) {
+            const Vector2i chunk_pos(cx, cy);
+            const Chunk2D* chunk = static_cast<const ChunkManager*>(chunk_manager)->get_chunk(chunk_pos);
+            if (!chunk) {
+                continue;
+            }
+
+            auto it = shapes.find(chunk_pos);
+            if (it == shapes.end()) {
+                if (!spare_shapes.empty()) {
+                    it = shapes.emplace(chunk_pos, std::move(spare_shapes.back())).first;
+                    spare_shapes.pop_back();
+                    it->second.dirty = true;
+                } else {
+                    it = shapes.emplace(chunk_pos, ChunkShapes()).first;
+                }
+            }
+            if (!it->second.dirty) {
+                continue;
+            }
+
+            merge_rects(chunk->solid_rows.data(), chunk->platform_rows.data(), it->second.rects);
+            it->second.dirty = false;
+            stats.chunks_rebuilt++;
+            stats.rects_rebuilt += it->second.rects.size();
+
+            released_chunks.erase(std::remove(released_chunks.begin(), released_chunks.end(), chunk_pos), released_chunks.end());
+            if (std::find(updated_chunks.begin(), updated_chunks.end(), chunk_pos) == updated_chunks.end()) {
+                updated_chunks.push_back(chunk_pos);
+            }
+        }
+    }
+
+    stats.active_chunks = shapes.size();
+    stats.active_rects = 0;
+    for (const auto& pair : shapes) {
+        stats.active_rects += pair.second.rects.size();
+    }
+
+    stats.update_usec = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count());
+}
+
+void TerrainCollisionSystem::apply_block_events(const BlockChangeEvent* events, size_t count) {
+    if (count == 0 || shapes.empty()) {
+        return;
+    }
+
+    // Background walls never collide; type-only updates (regeneration) change nothing
+    changed_chunks.clear();
+    for (size_t i = 0; i < count; i++) {
+        const BlockChangeEvent& event = events[i];
+        if (event.is_background || event.old_type == event.new_type) {
+            continue;
+        }
+        Vector2i chunk_pos = WorldCoords::tile_to_chunk(Vector2i(event.tile_x, event.tile_y));
+        if (std::find(changed_chunks.begin(), changed_chunks.end(), chunk_pos) == changed_chunks.end()) {
+            changed_chunks.push_back(chunk_pos);
+        }
+    }
+
+    // Event tiles are wrapped, active chunks may not be
+    for (auto& pair : shapes) {
+        const Vector2i wrapped = WorldCoords::wrap_chunk_x(pair.first);
+        if (std::find(changed_chunks.begin(), changed_chunks.end(), wrapped) != changed_chunks.end()) {
+            pair.second.dirty = true;
+        }
+    }
+}
+
+void TerrainCollisionSystem::clear_results() {
+    updated_chunks.clear();
+    released_chunks.clear();
+}
+
+const std::vector<CollisionRect>* TerrainCollisionSystem::get_rects(Vector2i chunk_pos) const {
+    auto it = shapes.find(chunk_pos);
+    return it != shapes.end() ? &it->second.rects : nullptr;
+}
+
+void TerrainCollisionSystem::set_focus(Vector2i tile_pos) {
+    focus_chunk = WorldCoords::tile_to_chunk(tile_pos);
+}
+
+void TerrainCollisionSystem::set_radius(Vector2i chunk_radius) {
+    radius = Vector2i(std::max(chunk_radius.x, 0), std::max(chunk_radius.y, 0));
+}
+
+void TerrainCollisionSystem::invalidate_all() {
+    for (auto& pair : shapes) {
+        pair.second.dirty = true;
+    }
+}
+
+void TerrainCollisionSystem::clear() {
+    for (auto& pair : shapes) {
+        released_chunks.push_back(pair.first);
+        spare_shapes.push_back(std::move(pair.second));
+    }
+    shapes.clear();
+    updated_chunks.clear();
+    stats = CollisionStats();
+}
+
+void TerrainCollisionSystem::merge_rects(const uint32_t* solid_rows, const uint32_t* platform_rows,
+                                         std::vector<CollisionRect>& out) {
+    out.clear();
+
+    // Lowest run of a row, grown down over every row that holds the whole run
+    uint32_t rows[CHUNK_HEIGHT];
+    std::copy(solid_rows, solid_rows + CHUNK_HEIGHT, rows);
+    for (int y = 0; y < CHUNK_HEIGHT; y++) {
+        while (rows[y] != 0) {
+            const int x = lowest_bit(rows[y]);
+            const uint32_t run = run_at(rows[y], x);
+            rows[y] &= ~run;
+
+            int height = 1;
+            while (y + height < CHUNK_HEIGHT && (rows[y + height] & run) == run) {
+                rows[y + height] &= ~run;
+                height++;
+            }
+
+            int width = 0;
+            for (uint32_t bits = run; bits != 0; bits &= bits - 1) {
+                width++;
+            }
+            out.push_back(CollisionRect(x, y, width, height, false));
+        }
+    }
+
+    // One-way shapes only work as thin tops, platforms merge along their row only
+    for (int y = 0; y < CHUNK_HEIGHT; y++) {
+        uint32_t row = platform_rows[y];
+        while (row != 0) {
+            const int x = lowest_bit(row);
+            const uint32_t run = run_at(row, x);
+            row &= ~run;
+
+            int width = 0;
+            for (uint32_t bits = run; bits != 0; bits &= bits - 1) {
+                width++;
+            }
+            out.push_back(CollisionRect(x, y, width, 1, true));
+        }
+    }
+}
@@ -0,0 +1,122 @@
+#ifndef TERRAIN_COLLISION_H
+#define TERRAIN_COLLISION_H
+
+#include "../world/world_constants.h"
+#include "../world/chunk_2d.h"
+#include "chunk_manager.h"
+#include "block_events.h"
+#include <godot_cpp/variant/vector2i.hpp>
+#include <unordered_map>
+#include <vector>
+#include <array>
+#include <cstdint>
+
+using namespace godot;
+
+// Chunks around the focus that get collision (each direction)
+constexpr int COLLISION_CHUNK_RADIUS_X = 2;
+constexpr int COLLISION_CHUNK_RADIUS_Y = 2;
+
+// One merged collision rectangle, in tiles relative to its chunk
+struct CollisionRect {
+    int8_t x;
+    int8_t y;
+    int8_t width;
+    int8_t height;
+    bool one_way;       // Platform: only collides from above
+
+    CollisionRect() : x(0), y(0), width(0), height(0), one_way(false) {}
+    CollisionRect(int px, int py, int w, int h, bool platform)
+        : x(static_cast<int8_t>(px)), y(static_cast<int8_t>(py))
+        , width(static_cast<int8_t>(w)), height(static_cast<int8_t>(h)), one_way(platform) {}
+};
+
+// Counters from the last collision update (for debug overlays and profiling)
+struct CollisionStats {
+    size_t chunks_rebuilt;
+    size_t rects_rebuilt;       // Rects of the chunks rebuilt this update
+    size_t active_chunks;
+    size_t active_rects;        // Shapes currently registered (all active chunks)
+    uint64_t update_usec;
+
+    CollisionStats()
+        : chunks_rebuilt(0)
+        , rects_rebuilt(0)
+        , active_chunks(0)
+        , active_rects(0)
+        , update_usec(0)
+    {}
+};
+
+// Terrain collision shapes around the focus
+// The chunk's collision rows (one 32-bit mask per row, kept by ChunkManager)
+// are greedily merged into rectangles: the lowest run of a row is grown down
+// while the rows below contain the whole run. Platforms (is_platform or the
+// IS_PLATFORM flag) become one-tile-tall one-way runs. Only chunks within the
+// collision radius of the focus have shapes; they are keyed by unwrapped
+// chunk position so bodies across the wrap seam sit next to the focus. Block
+// events rebuild just the chunks they touch. Like the mesher this only
+// produces plain data - the caller registers it with the physics server.
+class TerrainCollisionSystem {
+public:
+    struct ChunkShapes {
+        std::vector<CollisionRect> rects;
+        bool dirty;
+
+        ChunkShapes() : dirty(true) {}
+    };
+
+private:
+    ChunkManager* chunk_manager;
+    uint32_t collision_revision;        // Chunk collision rows already built from
+
+    // Active chunks by unwrapped chunk position
+    std::unordered_map<Vector2i, ChunkShapes, Vector2iHash> shapes;
+    std::vector<ChunkShapes> spare_shapes;
+
+    // Results of the last updates, until the caller has published them
+    std::vector<Vector2i> updated_chunks;
+    std::vector<Vector2i> released_chunks;
+
+    // Reused every update
+    std::vector<Vector2i> changed_chunks;       // Wrapped chunks touched by events
+
+    Vector2i focus_chunk;       // Unwrapped
+    Vector2i radius;
+
+    CollisionStats stats;
+
+public:
+    explicit TerrainCollisionSystem(ChunkManager* chunks);
+
+    // Rebuild dirty chunks near the focus, release chunks that left the radius
+    void update();
+
+    // Mark the chunks of changed foreground blocks
+    void apply_block_events(const BlockChangeEvent* events, size_t count);
+
+    // Chunks rebuilt / dropped since the last clear_results() (unwrapped positions)
+    const std::vector<Vector2i>& get_updated_chunks() const { return updated_chunks; }
+    const std::vector<Vector2i>& get_released_chunks() const { return released_chunks; }
+    void clear_results();
+
+    // Current rectangles of an active chunk (nullptr if inactive)
+    const std::vector<CollisionRect>* get_rects(Vector2i chunk_pos) const;
+
+    // Focus in tiles (unwrapped X is fine) and the chunk radius around it
+    void set_focus(Vector2i tile_pos);
+    void set_radius(Vector2i chunk_radius);
+
+    // Rebuild every active chunk
+    void invalidate_all();
+
+    const CollisionStats& get_stats() const { return stats; }
+
+    void clear();
+
+    // Greedy rectangles of one chunk from its row masks (bit x = column x)
+    static void merge_rects(const uint32_t* solid_rows, const uint32_t* platform_rows,
+                            std::vector<CollisionRect>& out);
+};
+
+#endif // TERRAIN_COLLISION_H
@@ -0,0 +1,286 @@
+#include "auto_tiling.h"
+#include <algorithm>
+
+using namespace godot;
+
+// Every row of a chunk
+static constexpr uint32_t ALL_COLUMNS = 0xFFFFFFFFu;
+
+// Mask -> pattern, patterns numbered by increasing reduced mask
+static std::array<uint8_t, 256> build_pattern_table() {
+    std::array<uint8_t, 256> reduced_index;
+    reduced_index.fill(0xFF);
+    uint8_t count = 0;
+    for (int mask = 0; mask < 256; mask++) {
+        // Reduced masks are fixed points of reduce_mask, in increasing order
+        if (AutoTileSystem::reduce_mask(static_cast<uint8_t>(mask)) == mask) {
+            reduced_index[mask] = count++;
+        }
+    }
+
+    std::array<uint8_t, 256> table;
+    for (int mask = 0; mask < 256; mask++) {
+        table[mask] = reduced_index[AutoTileSystem::reduce_mask(static_cast<uint8_t>(mask))];
+    }
+    return table;
+}
+
+static const std::array<uint8_t, 256> PATTERN_TABLE = build_pattern_table();
+
+AutoTileSystem::AutoTileSystem(ChunkManager* chunks, BlockRegistry* registry)
+    : chunk_manager(chunks)
+    , block_registry(registry)
+    , registry_version(0)
+{}
+
+uint8_t AutoTileSystem::reduce_mask(uint8_t mask) {
+    const bool up = (mask & AUTOTILE_UP) != 0;
+    const bool down = (mask & AUTOTILE_DOWN) != 0;
+    const bool left = (mask & AUTOTILE_LEFT) != 0;
+    const bool right = (mask & AUTOTILE_RIGHT) != 0;
+
+    uint8_t reduced = mask & (AUTOTILE_UP | AUTOTILE_DOWN | AUTOTILE_LEFT | AUTOTILE_RIGHT);
+    if (up && left) reduced |= mask & AUTOTILE_UP_LEFT;
+    if (up && right) reduced |= mask & AUTOTILE_UP_RIGHT;
+    if (down && left) reduced |= mask & AUTOTILE_DOWN_LEFT;
+    if (down && right) reduced |= mask & AUTOTILE_DOWN_RIGHT;
+    return reduced;
+}
+
+uint8_t AutoTileSystem::mask_to_pattern(uint8_t mask) {
+    return PATTERN_TABLE[mask];
+}
+
+void AutoTileSystem::update_chunk(Chunk2D* chunk) {
+    if (!chunk->dirty_autotile) {
+        return;
+    }
+
+    RowColumns all;
+    all.fill(ALL_COLUMNS);
+    retile(chunk, false, all);
+    retile(chunk, true, all);
+    chunk->dirty_autotile = false;
+    stats.chunks_tiled++;
+
+    // Border tiles of the neighbors blend with this chunk's edge
+    for (int dy = -1; dy <= 1; dy++) {
+        for (int dx = -1; dx <= 1; dx++) {
+            if (dx == 0 && dy == 0) {
+                continue;
+            }
+            Chunk2D* neighbor = chunk->get_neighbor(dx, dy);
+            if (!neighbor || neighbor->dirty_autotile) {
+                continue;
+            }
+
+            // The neighbor's column / row facing this chunk
+            const uint32_t columns = dx < 0 ? 1u << (CHUNK_WIDTH - 1) : dx > 0 ? 1u : ALL_COLUMNS;
+            RowColumns rim;
+            rim.fill(dy == 0 ? columns : 0);
+            if (dy < 0) {
+                rim[CHUNK_HEIGHT - 1] = columns;
+            } else if (dy > 0) {
+                rim[0] = columns;
+            }
+            retile(neighbor, false, rim);
+            retile(neighbor, true, rim);
+            stats.regions_tiled++;
+        }
+    }
+}
+
+void AutoTileSystem::apply_block_events(const BlockChangeEvent* events, size_t count) {
+    if (count == 0) {
+        return;
+    }
+
+    // Collect the 3x3 neighborhoods per chunk first, overlapping changes retile once
+    pending_regions.clear();
+    for (size_t i = 0; i < count; i++) {
+        const BlockChangeEvent& event = events[i];
+        if (event.old_type == event.new_type) {
+            continue;
+        }
+        for (int dy = -1; dy <= 1; dy++) {
+            for (int dx = -1; dx <= 1; dx++) {
+                Vector2i tile = WorldCoords::wrap_tile_x(Vector2i(event.tile_x + dx, event.tile_y + dy));
+                if (!WorldCoords::is_valid_y(tile.y)) {
+                    continue;
+                }
+                Vector2i local = WorldCoords::tile_to_local(tile);
+                auto it = pending_regions.find(WorldCoords::tile_to_chunk(tile));
+                if (it == pending_regions.end()) {
+                    std::array<RowColumns, 2> empty;
+                    empty[0].fill(0);
+                    empty[1].fill(0);
+                    it = pending_regions.emplace(WorldCoords::tile_to_chunk(tile), empty).first;
+                }
+                it->second[event.is_background ? 1 : 0][local.y] |= 1u << local.x;
+            }
+        }
+    }
+
+    for (const auto& pair : pending_regions) {
+        Chunk2D* chunk = chunk_manager->get_chunk(pair.first);
+        // Chunks waiting for their full pass are retiled whole anyway
+        if (!chunk || chunk->dirty_autotile) {
+            continue;
+        }
+        for (int layer = 0; layer < 2; layer++) {
+            const RowColumns& rows = pair.second[layer];
+            if (std::any_of(rows.begin(), rows.end(), [](uint32_t columns) { return columns != 0; })) {
+                retile(chunk, layer == 1, rows);
+                stats.regions_tiled++;
+            }
+        }
+    }
+}
+
+size_t AutoTileSystem::retile(Chunk2D* chunk, bool background, const RowColumns& rows) {
+    // Border rows read by the chosen tiles (tile row y reads rows y .. y + 2)
+    int first_row = CHUNK_HEIGHT;
+    int last_row = -1;
+    for (int y = 0; y < CHUNK_HEIGHT; y++) {
+        if (rows[y] != 0) {
+            first_row = std::min(first_row, y);
+            last_row = y + 2;
+        }
+    }
+    if (last_row < 0) {
+        return 0;
+    }
+
+    refresh_block_tables();
+    load_types(chunk, background, first_row, last_row);
+
+    // Row masks of every type present (bit c = border column c)
+    slot_types.clear();
+    for (int r = first_row; r <= last_row; r++) {
+        for (int c = 0; c < CHUNK_WIDTH + 2; c++) {
+            const uint16_t type = types[r][c];
+            if (type == 0 || type >= type_slots.size()) {
+                continue;
+            }
+            int16_t slot = type_slots[type];
+            if (slot < 0) {
+                slot = static_cast<int16_t>(slot_types.size());
+                type_slots[type] = slot;
+                slot_types.push_back(type);
+                if (slot_rows.size() < slot_types.size()) {
+                    slot_rows.resize(slot_types.size());
+                    slot_connects.resize(slot_types.size());
+                }
+                slot_rows[slot].fill(0);
+            }
+            slot_rows[slot][r] |= uint64_t(1) << c;
+        }
+    }
+
+    // Tiles each type blends with: its own rows plus those of its blends_with types
+    const size_t slot_count = slot_types.size();
+    for (size_t slot = 0; slot < slot_count; slot++) {
+        slot_connects[slot] = slot_rows[slot];
+        const std::vector<uint16_t>& blends = blend_table[slot_types[slot]];
+        for (uint16_t other : blends) {
+            int16_t other_slot = other < type_slots.size() ? type_slots[other] : -1;
+            if (other_slot < 0 || static_cast<size_t>(other_slot) == slot) {
+                continue;
+            }
+            for (int r = first_row; r <= last_row; r++) {
+                slot_connects[slot][r] |= slot_rows[other_slot][r];
+            }
+        }
+    }
+
+    // Tile (x, y) sits at border column x + 1: the rows above / at / below it
+    // shifted right by x put its three neighbors of each row in bits 0 - 2
+    auto& plane = background ? chunk->background : chunk->foreground;
+    auto& patterns = background ? chunk->background_autotile : chunk->foreground_autotile;
+    size_t changed = 0;
+    Vector2i changed_from(CHUNK_WIDTH, CHUNK_HEIGHT);
+    Vector2i changed_to(-1, -1);
+    for (int y = 0; y < CHUNK_HEIGHT; y++) {
+        const uint32_t columns = rows[y];
+        if (columns == 0) {
+            continue;
+        }
+        for (int x = 0; x < CHUNK_WIDTH; x++) {
+            if (((columns >> x) & 1u) == 0) {
+                continue;
+            }
+
+            const uint16_t type_id = plane.get_type(x, y);
+            uint8_t pattern = AUTOTILE_NONE;
+            if (type_id != 0 && type_id < type_slots.size() &&
+                (is_autotiled(type_id) || plane.has_flag(x, y, Block2D::SUPPORTS_BLEND))) {
+                const std::array<uint64_t, CHUNK_HEIGHT + 2>& connects = slot_connects[type_slots[type_id]];
+                const uint32_t above = static_cast<uint32_t>(connects[y] >> x) & 7u;
+                const uint32_t level = static_cast<uint32_t>(connects[y + 1] >> x) & 7u;
+                const uint32_t below = static_cast<uint32_t>(connects[y + 2] >> x) & 7u;
+                const uint32_t mask = above | ((level & 1u) << 3) | ((level >> 2) << 4) | (below << 5);
+                pattern = PATTERN_TABLE[mask];
+            }
+            if (patterns[x][y] != pattern) {
+                patterns[x][y] = pattern;
+                changed_from = Vector2i(std::min(changed_from.x, x), std::min(changed_from.y, y));
+                changed_to = Vector2i(std::max(changed_to.x, x), std::max(changed_to.y, y));
+                changed++;
+            }
+        }
+    }
+
+    for (uint16_t type : slot_types) {
+        type_slots[type] = -1;
+    }
+
+    if (changed > 0) {
+        chunk->mark_edited(CHUNK_LAYER_AUTOTILE, changed_from.x, changed_from.y, changed_to.x, changed_to.y);
+        stats.tiles_changed += changed;
+    }
+    return changed;
+}
+
+void AutoTileSystem::invalidate_all() {
+    for (const auto& pair : chunk_manager->get_all_chunks()) {
+        pair.second->dirty_autotile = true;
+    }
+}
+
+void AutoTileSystem::refresh_block_tables() {
+    if (!autotile_table.empty() && registry_version == block_registry->get_version()) {
+        return;
+    }
+    bool had_table = !autotile_table.empty();
+    registry_version = block_registry->get_version();
+
+    const size_t type_count = static_cast<size_t>(block_registry->get_max_block_id()) + 1;
+    autotile_table.assign(type_count, 0);
+    blend_table.assign(type_count, std::vector<uint16_t>());
+    for (const auto& pair : block_registry->get_all_blocks()) {
+        if (pair.first < type_count) {
+            autotile_table[pair.first] = pair.second.use_autotile ? 1 : 0;
+            blend_table[pair.first] = pair.second.blends_with;
+        }
+    }
+    autotile_table[0] = 0;
+    type_slots.assign(type_count, -1);
+
+    // Blending changed under already tiled chunks
+    if (had_table) {
+        invalidate_all();
+    }
+}
+
+void AutoTileSystem::load_types(const Chunk2D* chunk, bool background, int first_row, int last_row) {
+    // Border tiles come from the 8 neighbor chunks (missing ones count as air)
+    if (background) {
+        chunk->gather_ghost_rows(types, first_row, last_row, [](const Chunk2D& source, int x, int y) {
+            return source.background.get_type(x, y);
+        }, static_cast<uint16_t>(0));
+    } else {
+        chunk->gather_ghost_rows(types, first_row, last_row, [](const Chunk2D& source, int x, int y) {
+            return source.foreground.get_type(x, y);
+        }, static_cast<uint16_t>(0));
+    }
+}
@@ -0,0 +1,118 @@
+#ifndef AUTO_TILING_H
+#define AUTO_TILING_H
+
+#include "../world/world_constants.h"
+#include "../world/chunk_2d.h"
+#include "../core/chunk_manager.h"
+#include "../core/block_registry.h"
+#include "../core/block_events.h"
+#include <godot_cpp/variant/vector2i.hpp>
+#include <unordered_map>
+#include <vector>
+#include <array>
+#include <cstdint>
+
+using namespace godot;
+
+// Distinct tile shapes once corners without both adjacent edges are ignored
+constexpr int AUTOTILE_PATTERN_COUNT = 47;
+
+// Neighbor bits of an autotile mask (row-major around the tile, up = -Y)
+enum AutoTileNeighbor : uint8_t {
+    AUTOTILE_UP_LEFT    = 1 << 0,
+    AUTOTILE_UP         = 1 << 1,
+    AUTOTILE_UP_RIGHT   = 1 << 2,
+    AUTOTILE_LEFT       = 1 << 3,
+    AUTOTILE_RIGHT      = 1 << 4,
+    AUTOTILE_DOWN_LEFT  = 1 << 5,
+    AUTOTILE_DOWN       = 1 << 6,
+    AUTOTILE_DOWN_RIGHT = 1 << 7
+};
+
+// Counters from the last autotile pass (for debug overlays and profiling)
+struct AutoTileStats {
+    size_t chunks_tiled;        // Full chunk passes
+    size_t regions_tiled;       // Partial passes (event neighborhoods, chunk rims)
+    size_t tiles_changed;
+
+    AutoTileStats()
+        : chunks_tiled(0)
+        , regions_tiled(0)
+        , tiles_changed(0)
+    {}
+};
+
+// 47-tile (blob) autotiler
+// A tile blends with neighbors of its own type and of its definition's
+// blends_with types. Each pass loads the chunk plus a one-tile border from
+// the neighbor chunks (X wraps), turns every type present into 34-bit row
+// masks, and ORs those into one "connects to" mask set per type. A tile's
+// 8-neighbor mask is then three shifted rows of its type's set, and a
+// 256-entry table maps it to its pattern, cached per tile in the chunk.
+// New chunks get a full pass (dirty_autotile); block changes only retile the
+// 3x3 neighborhood of each changed tile. Changed patterns are recorded as
+// CHUNK_LAYER_AUTOTILE edits.
+class AutoTileSystem {
+public:
+    // Tiles of one chunk row to retile (bit x = local column x)
+    using RowColumns = std::array<uint32_t, CHUNK_HEIGHT>;
+
+private:
+    ChunkManager* chunk_manager;
+    BlockRegistry* block_registry;
+
+    // Per block type: use_autotile, and the other types it blends with
+    std::vector<uint8_t> autotile_table;
+    std::vector<std::vector<uint16_t>> blend_table;
+    uint32_t registry_version;
+
+    // Scratch of one pass: types of the chunk and its border ([row][column], +1 offset)
+    std::array<std::array<uint16_t, CHUNK_WIDTH + 2>, CHUNK_HEIGHT + 2> types;
+    std::vector<int16_t> type_slots;                        // Type -> slot of this pass (-1 = absent)
+    std::vector<uint16_t> slot_types;                       // Slot -> type
+    std::vector<std::array<uint64_t, CHUNK_HEIGHT + 2>> slot_rows;      // Tiles of a type per row
+    std::vector<std::array<uint64_t, CHUNK_HEIGHT + 2>> slot_connects;  // Tiles a type blends with per row
+
+    // Event neighborhoods per chunk and layer, reused every frame
+    std::unordered_map<Vector2i, std::array<RowColumns, 2>, Vector2iHash> pending_regions;
+
+    AutoTileStats stats;
+
+public:
+    AutoTileSystem(ChunkManager* chunks, BlockRegistry* registry);
+
+    // Pattern (0 - 46) of an 8-neighbor mask; patterns are numbered by
+    // increasing reduced mask, so 0 is isolated and 46 fully surrounded
+    static uint8_t mask_to_pattern(uint8_t mask);
+
+    // Drop corner bits whose two adjacent edges aren't both connected
+    static uint8_t reduce_mask(uint8_t mask);
+
+    // Full pass over a chunk with dirty_autotile, then the rims of its neighbors
+    void update_chunk(Chunk2D* chunk);
+
+    // Retile the 3x3 neighborhood of every changed tile
+    void apply_block_events(const BlockChangeEvent* events, size_t count);
+
+    // Retile the chosen tiles of one layer; returns the number of changed patterns
+    size_t retile(Chunk2D* chunk, bool background, const RowColumns& rows);
+
+    // Every loaded chunk gets a full pass again
+    void invalidate_all();
+
+    const AutoTileStats& get_stats() const { return stats; }
+    void reset_stats() { stats = AutoTileStats(); }
+
+private:
+    // Reload per-type tables when the registry changes
+    void refresh_block_tables();
+
+    // Fill rows first_row .. last_row of `types` with the chunk layer and its border
+    void load_types(const Chunk2D* chunk, bool background, int first_row, int last_row);
+
+    inline bool is_autotiled(uint16_t type) const {
+        return type < autotile_table.size() && autotile_table[type] != 0;
+    }
+};
+
+#endif // AUTO_TILING_H
@@ -0,0 +1,465 @@
+#include "chunk_mesher.h"
+#include <algorithm>
+#include <chrono>
+
+using namespace godot;
+
+// Corners along one side of a chunk
+static constexpr int CORNER_STRIDE = CHUNK_WIDTH + 1;
+
+static constexpr uint32_t ALL_ROWS = 0xFFFFFFFFu;
+
+// Row bits first..last (inclusive)
+static inline uint32_t row_span(int first, int last) {
+    const uint32_t below_last = last >= CHUNK_HEIGHT - 1 ? ALL_ROWS : (1u << (last + 1)) - 1;
+    return below_last & ~((1u << first) - 1);
+}
+
+// Index of the lowest set bit (mask != 0)
+static inline int lowest_bit(uint32_t mask) {
+    int index = 0;
+    while ((mask & 1u) == 0) {
+        mask >>= 1;
+        index++;
+    }
+    return index;
+}
+
+// Index of the highest set bit (mask != 0)
+static inline int highest_bit(uint32_t mask) {
+    int index = 0;
+    while (mask >>= 1) {
+        index++;
+    }
+    return index;
+}
+
+// Chunk distance between two (wrapped) chunk positions, X wraps around the world
+static inline int chunk_distance(Vector2i a, Vector2i b) {
+    int dx = std::abs(a.x - b.x);
+    dx = std::min(dx, CHUNKS_HORIZONTAL - dx);
+    return std::max(dx, std::abs(a.y - b.y));
+}
+
+// One quad for the tile at (x, y); corners are clockwise from the top-left
+static inline void emit_quad(ChunkMeshData& out, int x, int y, const Block2D& block, uint8_t pattern,
+                             const uint8_t* corner_light, Vector2 atlas_cell, float shade) {
+    const int32_t base = static_cast<int32_t>(out.vertices.size());
+    const float px = static_cast<float>(x * TILE_SIZE_PIXELS);
+    const float py = static_cast<float>(y * TILE_SIZE_PIXELS);
+    const float size = static_cast<float>(TILE_SIZE_PIXELS);
+
+    out.vertices.push_back(Vector2(px, py));
+    out.vertices.push_back(Vector2(px + size, py));
+    out.vertices.push_back(Vector2(px + size, py + size));
+    out.vertices.push_back(Vector2(px, py + size));
+
+    const float u = (pattern != AUTOTILE_NONE ? pattern : block.variant) * atlas_cell.x;
+    const float v = block.type_id * atlas_cell.y;
+    out.uvs.push_back(Vector2(u, v));
+    out.uvs.push_back(Vector2(u + atlas_cell.x, v));
+    out.uvs.push_back(Vector2(u + atlas_cell.x, v + atlas_cell.y));
+    out.uvs.push_back(Vector2(u, v + atlas_cell.y));
+
+    const uint8_t* top = corner_light + y * CORNER_STRIDE + x;
+    const uint8_t* bottom = top + CORNER_STRIDE;
+    const float scale = shade / 255.0f;
+    const uint8_t light[4] = { top[0], top[1], bottom[1], bottom[0] };
+    for (int i = 0; i < 4; i++) {
+        float level = light[i] * scale;
+        out.colors.push_back(Color(level, level, level, 1.0f));
+    }
+
+    out.indices.push_back(base);
+    out.indices.push_back(base + 1);
+    out.indices.push_back(base + 2);
+    out.indices.push_back(base);
+    out.indices.push_back(base + 2);
+    out.indices.push_back(base + 3);
+}
+
+// Append quads [first, end) of src to out (indices follow their new position)
+static inline void copy_quads(const ChunkMeshData& src, size_t first, size_t end, ChunkMeshData& out) {
+    if (end <= first) {
+        return;
+    }
+    int32_t base = static_cast<int32_t>(out.vertices.size());
+    out.vertices.insert(out.vertices.end(), src.vertices.begin() + first * 4, src.vertices.begin() + end * 4);
+    out.uvs.insert(out.uvs.end(), src.uvs.begin() + first * 4, src.uvs.begin() + end * 4);
+    out.colors.insert(out.colors.end(), src.colors.begin() + first * 4, src.colors.begin() + end * 4);
+    for (size_t i = first; i < end; i++, base += 4) {
+        out.indices.push_back(base);
+        out.indices.push_back(base + 1);
+        out.indices.push_back(base + 2);
+        out.indices.push_back(base);
+        out.indices.push_back(base + 2);
+        out.indices.push_back(base + 3);
+    }
+}
+
+ChunkMesher::ChunkMesher(ChunkManager* chunks, BlockRegistry* registry,
+                         SmoothLighting* smooth, AutoTileSystem* tiles, ThreadPool* pool)
+    : chunk_manager(chunks)
+    , block_registry(registry)
+    , smooth_lighting(smooth)
+    , seen_corner_revision(smooth ? smooth->get_corner_revision() : 0)
+    , auto_tiling(tiles)
+    , thread_pool(pool)
+    , registry_version(0)
+    , atlas_columns(MESH_ATLAS_COLUMNS)
+    , atlas_rows(0)
+    , atlas_cell(1.0f / MESH_ATLAS_COLUMNS, 1.0f)
+    , focus_chunk(0, 0)
+    , rebuild_budget(MESH_REBUILD_CHUNK_BUDGET)
+{}
+
+void ChunkMesher::update() {
+    auto start = std::chrono::steady_clock::now();
+    stats.chunks_meshed = 0;
+    stats.chunks_partial = 0;
+    stats.chunks_pending = 0;
+    stats.quads = 0;
+
+    refresh_block_tables();
+    mark_smooth_light_changes();
+    collect_dirty_chunks();
+
+    // Nearest the focus first, the rest stay dirty for later updates
+    if (dirty_chunks.size() > rebuild_budget) {
+        const Vector2i focus = focus_chunk;
+        std::nth_element(dirty_chunks.begin(), dirty_chunks.begin() + rebuild_budget, dirty_chunks.end(),
+                         [focus](const DirtyChunk& a, const DirtyChunk& b) {
+            return chunk_distance(a.chunk->chunk_position, focus) < chunk_distance(b.chunk->chunk_position, focus);
+        });
+        stats.chunks_pending = dirty_chunks.size() - rebuild_budget;
+        dirty_chunks.resize(rebuild_budget);
+    }
+
+    // New chunks need their patterns first (retiling touches neighbor chunks, so not on workers)
+    if (auto_tiling) {
+        for (DirtyChunk& dirty : dirty_chunks) {
+            if (dirty.chunk->dirty_autotile) {
+                auto_tiling->update_chunk(dirty.chunk);
+                dirty.rows = ALL_ROWS;
+            }
+        }
+    }
+
+    // Output buffers are picked on this thread (map nodes don't move on insert)
+    batch_meshes.clear();
+    for (const DirtyChunk& dirty : dirty_chunks) {
+        const Chunk2D* chunk = dirty.chunk;
+        auto it = meshes.find(chunk->chunk_position);
+        if (it == meshes.end()) {
+            if (!spare_meshes.empty()) {
+                it = meshes.emplace(chunk->chunk_position, std::move(spare_meshes.back())).first;
+                spare_meshes.pop_back();
+            } else {
+                it = meshes.emplace(chunk->chunk_position, ChunkMeshData()).first;
+            }
+        }
+        batch_meshes.push_back(&it->second);
+    }
+
+    // Chunks are independent - each job reads one chunk and writes its own buffers
+    // A few edited rows are spliced into the existing mesh, wider edits rebuild it
+    row_scratch.resize(thread_pool ? thread_pool->get_worker_count() : 1);
+    auto mesh_chunk = [this](size_t index, int worker) {
+        const DirtyChunk& dirty = dirty_chunks[index];
+        const int first_row = lowest_bit(dirty.rows);
+        const int last_row = highest_bit(dirty.rows);
+        if (last_row - first_row + 1 >= CHUNK_HEIGHT / 2) {
+            build_mesh(*dirty.chunk, *batch_meshes[index]);
+        } else {
+            rebuild_rows(*dirty.chunk, *batch_meshes[index], first_row, last_row, row_scratch[worker]);
+        }
+    };
+    if (thread_pool) {
+        thread_pool->parallel_for(dirty_chunks.size(), mesh_chunk);
+    } else {
+        for (size_t i = 0; i < dirty_chunks.size(); i++) {
+            mesh_chunk(i, 0);
+        }
+    }
+
+    for (size_t i = 0; i < dirty_chunks.size(); i++) {
+        const Chunk2D* chunk = dirty_chunks[i].chunk;
+        ChunkMeshData& mesh = *batch_meshes[i];
+        mesh.chunk_version = chunk->edit_version;
+        mesh.stale_rows = 0;
+        stats.quads += mesh.get_quad_count();
+        const int row_span_count = highest_bit(dirty_chunks[i].rows) - lowest_bit(dirty_chunks[i].rows) + 1;
+        stats.chunks_partial += row_span_count < CHUNK_HEIGHT / 2 ? 1 : 0;
+
+        const Vector2i pos = chunk->chunk_position;
+        released_chunks.erase(std::remove(released_chunks.begin(), released_chunks.end(), pos), released_chunks.end());
+        if (std::find(updated_chunks.begin(), updated_chunks.end(), pos) == updated_chunks.end()) {
+            updated_chunks.push_back(pos);
+        }
+    }
+    stats.chunks_meshed = dirty_chunks.size();
+
+    stats.update_usec = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count());
+}
+
+void ChunkMesher::clear_results() {
+    updated_chunks.clear();
+    released_chunks.clear();
+}
+
+const ChunkMeshData* ChunkMesher::get_mesh(Vector2i chunk_pos) const {
+    auto it = meshes.find(chunk_pos);
+    return it != meshes.end() ? &it->second : nullptr;
+}
+
+void ChunkMesher::build_mesh(const Chunk2D& chunk, ChunkMeshData& out) const {
+    out.clear();
+    if (chunk.foreground_occupancy.is_empty() && chunk.background_occupancy.is_empty()) {
+        return;
+    }
+
+    uint8_t corner_light[CORNER_STRIDE * (CHUNK_HEIGHT + 1)];
+    gather_corner_light(chunk, corner_light);
+
+    // Background first, except where an opaque foreground tile covers it
+    emit_rows(chunk, true, 0, CHUNK_HEIGHT - 1, corner_light, out);
+    out.background_quads = static_cast<uint32_t>(out.get_quad_count());
+    emit_rows(chunk, false, 0, CHUNK_HEIGHT - 1, corner_light, out);
+}
+
+void ChunkMesher::rebuild_rows(const Chunk2D& chunk, ChunkMeshData& mesh, int first_row, int last_row,
+                               ChunkMeshData& scratch) const {
+    scratch.clear();
+
+    uint8_t corner_light[CORNER_STRIDE * (CHUNK_HEIGHT + 1)];
+    gather_corner_light(chunk, corner_light);
+
+    // Per layer: rows above copied, edited rows emitted again, rows below copied
+    for (int layer = 0; layer < 2; layer++) {
+        const bool background = layer == 0;
+        const std::array<uint16_t, CHUNK_HEIGHT + 1>& old_rows = background ? mesh.background_rows : mesh.foreground_rows;
+        std::array<uint16_t, CHUNK_HEIGHT + 1>& new_rows = background ? scratch.background_rows : scratch.foreground_rows;
+
+        int shift = static_cast<int>(scratch.get_quad_count()) - old_rows[0];
+        for (int y = 0; y < first_row; y++) {
+            new_rows[y] = static_cast<uint16_t>(old_rows[y] + shift);
+        }
+        copy_quads(mesh, old_rows[0], old_rows[first_row], scratch);
+
+        emit_rows(chunk, background, first_row, last_row, corner_light, scratch);
+
+        shift = static_cast<int>(scratch.get_quad_count()) - old_rows[last_row + 1];
+        for (int y = last_row + 1; y <= CHUNK_HEIGHT; y++) {
+            new_rows[y] = static_cast<uint16_t>(old_rows[y] + shift);
+        }
+        copy_quads(mesh, old_rows[last_row + 1], old_rows[CHUNK_HEIGHT], scratch);
+    }
+    scratch.background_quads = scratch.background_rows[CHUNK_HEIGHT];
+
+    std::swap(mesh, scratch);
+}
+
+void ChunkMesher::emit_rows(const Chunk2D& chunk, bool background, int first_row, int last_row,
+                            const uint8_t* corner_light, ChunkMeshData& out) const {
+    // Only the non-air tiles of each row are visited (occupancy row masks)
+    if (background) {
+        for (int y = first_row; y <= last_row; y++) {
+            out.background_rows[y] = static_cast<uint16_t>(out.get_quad_count());
+            for (uint32_t bits = chunk.background_occupancy.get_row(y); bits != 0; bits &= bits - 1) {
+                const int x = lowest_bit(bits);
+                if (occludes(chunk.foreground.get_type(x, y))) {
+                    continue;
+                }
+                emit_quad(out, x, y, chunk.background.get(x, y), chunk.background_autotile[x][y], corner_light,
+                          atlas_cell, MESH_BACKGROUND_SHADE);
+            }
+        }
+        out.background_rows[last_row + 1] = static_cast<uint16_t>(out.get_quad_count());
+    } else {
+        for (int y = first_row; y <= last_row; y++) {
+            out.foreground_rows[y] = static_cast<uint16_t>(out.get_quad_count());
+            for (uint32_t bits = chunk.foreground_occupancy.get_row(y); bits != 0; bits &= bits - 1) {
+                const int x = lowest_bit(bits);
+                emit_quad(out, x, y, chunk.foreground.get(x, y), chunk.foreground_autotile[x][y], corner_light,
+                          atlas_cell, 1.0f);
+            }
+        }
+        out.foreground_rows[last_row + 1] = static_cast<uint16_t>(out.get_quad_count());
+    }
+}
+
+void ChunkMesher::set_atlas_grid(int columns, int rows) {
+    atlas_columns = std::max(columns, 1);
+    atlas_rows = std::max(rows, 0);
+    update_atlas_cell();
+    invalidate_all();
+}
+
+void ChunkMesher::set_focus(Vector2i tile_pos) {
+    focus_chunk = WorldCoords::tile_to_chunk(WorldCoords::wrap_tile_x(tile_pos));
+}
+
+void ChunkMesher::invalidate_all() {
+    // Chunks without a mesh are built on their own
+    for (auto& pair : meshes) {
+        pair.second.stale_rows = ALL_ROWS;
+    }
+}
+
+void ChunkMesher::clear() {
+    // Buffers stay around for the chunks of the next world
+    for (auto& pair : meshes) {
+        released_chunks.push_back(pair.first);
+        spare_meshes.push_back(std::move(pair.second));
+    }
+    meshes.clear();
+    updated_chunks.clear();
+    stats = ChunkMesherStats();
+}
+
+void ChunkMesher::refresh_block_tables() {
+    if (!occludes_table.empty() && registry_version == block_registry->get_version()) {
+        return;
+    }
+    bool had_table = !occludes_table.empty();
+    registry_version = block_registry->get_version();
+
+    const size_t type_count = static_cast<size_t>(block_registry->get_max_block_id()) + 1;
+    occludes_table.assign(type_count, 0);
+    for (const auto& pair : block_registry->get_all_blocks()) {
+        if (pair.first < type_count) {
+            occludes_table[pair.first] = pair.second.light_opacity == 255 ? 1 : 0;
+        }
+    }
+    occludes_table[0] = 0;
+    update_atlas_cell();
+
+    // Occlusion or atlas rows changed under already meshed chunks
+    if (had_table) {
+        invalidate_all();
+    }
+}
+
+void ChunkMesher::update_atlas_cell() {
+    int rows = atlas_rows > 0 ? atlas_rows : static_cast<int>(std::max<size_t>(occludes_table.size(), 1));
+    atlas_cell = Vector2(1.0f / atlas_columns, 1.0f / rows);
+}
+
+void ChunkMesher::mark_smooth_light_changes() {
+    if (!smooth_lighting || smooth_lighting->get_corner_revision() == seen_corner_revision) {
+        return;
+    }
+    seen_corner_revision = smooth_lighting->get_corner_revision();
+
+    // Corner c is shared by tiles c - 1 and c on each axis
+    const Vector2i view_position = smooth_lighting->get_view().position;
+    for (const Rect2i& rect : smooth_lighting->get_dirty_rects()) {
+        const Vector2i from = view_position + rect.position - Vector2i(1, 1);
+        const Vector2i to = view_position + rect.position + rect.size - Vector2i(1, 1);
+        for (int cy = WorldGrid::chunk_y(from.y); cy <= WorldGrid::chunk_y(to.y); cy++) {
+            const uint32_t rows = row_span(std::max(from.y - WorldGrid::origin_y(cy), 0),
+                                           std::min(to.y - WorldGrid::origin_y(cy), CHUNK_HEIGHT - 1));
+            for (int cx = WorldGrid::chunk_x(from.x); cx <= WorldGrid::chunk_x(to.x); cx++) {
+                // Chunks without a mesh are built whole anyway
+                auto it = meshes.find(Vector2i(WorldGrid::wrap_chunk_x(cx), cy));
+                if (it != meshes.end()) {
+                    it->second.stale_rows |= rows;
+                }
+            }
+        }
+    }
+}
+
+void ChunkMesher::collect_dirty_chunks() {
+    dirty_chunks.clear();
+    for (auto it = meshes.begin(); it != meshes.end();) {
+        Chunk2D* chunk = chunk_manager->get_chunk(it->first);
+        if (!chunk) {
+            updated_chunks.erase(std::remove(updated_chunks.begin(), updated_chunks.end(), it->first), updated_chunks.end());
+            released_chunks.push_back(it->first);
+            spare_meshes.push_back(std::move(it->second));
+            it = meshes.erase(it);
+            continue;
+        }
+
+        // Edits the mesh doesn't draw (liquids) only move its version forward
+        const uint32_t rows = get_stale_rows(*chunk, it->second);
+        if (rows != 0) {
+            dirty_chunks.push_back({ chunk, rows });
+        } else {
+            it->second.chunk_version = chunk->edit_version;
+        }
+        ++it;
+    }
+
+    // New chunks (only while some loaded chunk has no mesh yet)
+    if (chunk_manager->get_loaded_chunk_count() > meshes.size()) {
+        for (const auto& pair : chunk_manager->get_all_chunks()) {
+            if (meshes.find(pair.first) == meshes.end()) {
+                dirty_chunks.push_back({ pair.second.get(), ALL_ROWS });
+            }
+        }
+    }
+}
+
+uint32_t ChunkMesher::get_stale_rows(const Chunk2D& chunk, const ChunkMeshData& mesh) const {
+    if (chunk.edit_version == mesh.chunk_version) {
+        return mesh.stale_rows;
+    }
+    // Versions went back: a different chunk took this position
+    if (chunk.edit_version < mesh.chunk_version) {
+        return ALL_ROWS;
+    }
+
+    uint32_t rows = mesh.stale_rows;
+    Rect2i region;
+    static const ChunkLayer TILE_LAYERS[] = { CHUNK_LAYER_FOREGROUND, CHUNK_LAYER_BACKGROUND, CHUNK_LAYER_AUTOTILE };
+    for (ChunkLayer layer : TILE_LAYERS) {
+        if (chunk.get_changes_since(layer, mesh.chunk_version, region)) {
+            rows |= row_span(region.position.y, region.position.y + region.size.y - 1);
+        }
+    }
+    // A tile's light is the top-left corner of its own quad and a bottom corner of the quad above
+    if (chunk.get_changes_since(CHUNK_LAYER_LIGHT, mesh.chunk_version, region)) {
+        rows |= row_span(std::max(region.position.y - 1, 0), region.position.y + region.size.y - 1);
+    }
+    return rows;
+}
+
+void ChunkMesher::gather_corner_light(const Chunk2D& chunk, uint8_t* out) const {
+    // Flat light of the tile below-right of each corner (clamped at the far edges)
+    for (int y = 0; y <= CHUNK_HEIGHT; y++) {
+        const int tile_y = std::min(y, CHUNK_HEIGHT - 1);
+        for (int x = 0; x <= CHUNK_WIDTH; x++) {
+            out[y * CORNER_STRIDE + x] = chunk.lighting[std::min(x, CHUNK_WIDTH - 1)][tile_y];
+        }
+    }
+
+    if (!smooth_lighting || smooth_lighting->get_corner_width() == 0) {
+        return;
+    }
+
+    // Smooth corners wherever the view covers them (the view X may be unwrapped)
+    const Vector2i view_position = smooth_lighting->get_view().position;
+    const int corner_width = smooth_lighting->get_corner_width();
+    const int corner_height = smooth_lighting->get_corner_height();
+    const uint8_t* corners = smooth_lighting->get_corners();
+
+    const int first_x = WorldGrid::origin_x(chunk.chunk_position.x) - view_position.x;
+    const int first_y = WorldGrid::origin_y(chunk.chunk_position.y) - view_position.y;
+    for (int y = 0; y <= CHUNK_HEIGHT; y++) {
+        const int row = first_y + y;
+        if (row < 0 || row >= corner_height) {
+            continue;
+        }
+        const uint8_t* src = corners + row * corner_width;
+        uint8_t* dst = out + y * CORNER_STRIDE;
+        for (int x = 0; x <= CHUNK_WIDTH; x++) {
+            const int column = WorldCoords::wrap_x(first_x + x);
+            if (column < corner_width) {
+                dst[x] = src[column];
+            }
+        }
+    }
+}
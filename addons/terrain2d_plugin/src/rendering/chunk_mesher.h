@@ -0,0 +1,209 @@
+#ifndef CHUNK_MESHER_H
+#define CHUNK_MESHER_H
+
+#include "../world/world_constants.h"
+#include "../world/chunk_2d.h"
+#include "../core/chunk_manager.h"
+#include "../core/block_registry.h"
+#include "../utils/thread_pool.h"
+#include "smooth_lighting.h"
+#include "auto_tiling.h"
+#include <godot_cpp/variant/vector2.hpp>
+#include <godot_cpp/variant/vector2i.hpp>
+#include <godot_cpp/variant/color.hpp>
+#include <unordered_map>
+#include <vector>
+#include <array>
+#include <cstdint>
+
+using namespace godot;
+
+// Chunks meshed per update at most (nearest the focus first, the rest wait)
+constexpr size_t MESH_REBUILD_CHUNK_BUDGET = 32;
+
+// Background tiles are drawn at this fraction of their light
+constexpr float MESH_BACKGROUND_SHADE = 0.5f;
+
+// Default atlas layout: one column per autotile pattern (or variant for
+// blocks that don't autotile), one row per block type
+constexpr int MESH_ATLAS_COLUMNS = AUTOTILE_PATTERN_COUNT;
+
+// Vertex buffers of one chunk (4 vertices and 6 indices per quad)
+// Vertices are in pixels relative to the chunk's top-left tile corner; the
+// layout matches ArrayMesh's ARRAY_VERTEX / ARRAY_TEX_UV / ARRAY_COLOR /
+// ARRAY_INDEX so publishing is a straight copy into the packed arrays.
+// Background quads come first, so drawing in order puts foreground on top.
+// Within a layer quads are in row order, which lets edited rows be replaced
+// without rebuilding the rest.
+struct ChunkMeshData {
+    std::vector<Vector2> vertices;
+    std::vector<Vector2> uvs;
+    std::vector<Color> colors;
+    std::vector<int32_t> indices;
+    uint32_t background_quads;      // Leading quads that belong to the background layer
+
+    // First quad of each row per layer (entry CHUNK_HEIGHT = end of the layer)
+    std::array<uint16_t, CHUNK_HEIGHT + 1> background_rows;
+    std::array<uint16_t, CHUNK_HEIGHT + 1> foreground_rows;
+
+    // Mesher bookkeeping
+    uint32_t chunk_version;         // Chunk edit_version the mesh is current with
+    uint32_t stale_rows;            // Rows to rebuild regardless of chunk edits (bit y = row y)
+
+    ChunkMeshData() : background_quads(0), chunk_version(0), stale_rows(0) {
+        background_rows.fill(0);
+        foreground_rows.fill(0);
+    }
+
+    size_t get_quad_count() const { return vertices.size() / 4; }
+
+    // Empty the buffers but keep their capacity for the next build
+    void clear() {
+        vertices.clear();
+        uvs.clear();
+        colors.clear();
+        indices.clear();
+        background_quads = 0;
+        background_rows.fill(0);
+        foreground_rows.fill(0);
+    }
+};
+
+// Counters from the last mesher update (for debug overlays and profiling)
+struct ChunkMesherStats {
+    size_t chunks_meshed;
+    size_t chunks_partial;      // Meshed chunks that only had their edited rows rebuilt
+    size_t chunks_pending;      // Dirty chunks left for later updates (over budget)
+    size_t quads;               // Quads in the meshes built this update
+    uint64_t update_usec;
+
+    ChunkMesherStats()
+        : chunks_meshed(0)
+        , chunks_partial(0)
+        , chunks_pending(0)
+        , quads(0)
+        , update_usec(0)
+    {}
+};
+
+// CPU mesher for chunk foreground and background
+// Every loaded chunk is turned into one quad per non-air tile; background
+// tiles hidden behind a fully opaque foreground tile are
+// skipped. UVs come from an atlas grid (column = autotile pattern, or variant
+// for tiles without one; row = type_id) and
+// vertex colors from the smooth per-corner light where the view covers the
+// chunk, the tile's own light elsewhere. Each mesh remembers the chunk
+// edit_version it was built from; on later updates only the rows whose
+// foreground, background, autotile or light layer changed since then are
+// rebuilt (a full build once they cover half the chunk), and edits of other
+// layers such as liquids cost nothing. Chunks are meshed on the thread pool
+// into buffers kept per chunk (and recycled from unloaded chunks), and only
+// their positions are handed back - the caller turns them into engine meshes
+// on the main thread, which keeps this class free of engine calls.
+class ChunkMesher {
+private:
+    ChunkManager* chunk_manager;
+    BlockRegistry* block_registry;
+    SmoothLighting* smooth_lighting;    // Optional (flat tile light without it)
+    uint32_t seen_corner_revision;      // Smooth corner changes already marked dirty
+    AutoTileSystem* auto_tiling;        // Optional (full autotile pass of new chunks before meshing)
+    ThreadPool* thread_pool;            // Optional (meshes inline without it)
+
+    // Built meshes by (wrapped) chunk position
+    std::unordered_map<Vector2i, ChunkMeshData, Vector2iHash> meshes;
+    std::vector<ChunkMeshData> spare_meshes;    // Buffers of released chunks, reused first
+
+    // Results of the last update, until the caller has published them
+    std::vector<Vector2i> updated_chunks;
+    std::vector<Vector2i> released_chunks;
+
+    struct DirtyChunk {
+        Chunk2D* chunk;
+        uint32_t rows;      // Rows to rebuild (bit y = row y)
+    };
+
+    // Reused every update
+    std::vector<DirtyChunk> dirty_chunks;
+    std::vector<ChunkMeshData*> batch_meshes;
+    std::vector<ChunkMeshData> row_scratch;     // Per worker, swapped with meshes rebuilt by row
+
+    // Per block type: fully opaque (hides the background behind it)
+    std::vector<uint8_t> occludes_table;
+    uint32_t registry_version;
+
+    int atlas_columns;
+    int atlas_rows;                     // 0 = one row per registered type
+    Vector2 atlas_cell;                 // UV size of one atlas cell
+
+    Vector2i focus_chunk;
+    size_t rebuild_budget;
+
+    ChunkMesherStats stats;
+
+public:
+    ChunkMesher(ChunkManager* chunks, BlockRegistry* registry,
+                SmoothLighting* smooth = nullptr, AutoTileSystem* tiles = nullptr,
+                ThreadPool* pool = nullptr);
+
+    // Mesh dirty chunks (up to the budget), release meshes of unloaded chunks
+    void update();
+
+    // Chunks whose mesh was rebuilt / dropped by update() since the last clear_results()
+    const std::vector<Vector2i>& get_updated_chunks() const { return updated_chunks; }
+    const std::vector<Vector2i>& get_released_chunks() const { return released_chunks; }
+    void clear_results();
+
+    // Current mesh of a chunk (nullptr if it has none)
+    const ChunkMeshData* get_mesh(Vector2i chunk_pos) const;
+    size_t get_mesh_count() const { return meshes.size(); }
+
+    // Mesh one chunk (thread-safe while nothing modifies the chunk or the tables)
+    void build_mesh(const Chunk2D& chunk, ChunkMeshData& out) const;
+
+    // Rebuild rows first_row..last_row of a mesh built by build_mesh, keeping
+    // the other rows; the result is swapped into mesh (scratch gets the old buffers)
+    void rebuild_rows(const Chunk2D& chunk, ChunkMeshData& mesh, int first_row, int last_row,
+                      ChunkMeshData& scratch) const;
+
+    // Atlas grid in cells (rows <= 0 uses one row per registered type)
+    void set_atlas_grid(int columns, int rows);
+
+    // Chunks nearest this tile are meshed first
+    void set_focus(Vector2i tile_pos);
+    void set_rebuild_budget(size_t chunks) { rebuild_budget = chunks > 0 ? chunks : 1; }
+
+    // Rebuild every loaded chunk
+    void invalidate_all();
+
+    const ChunkMesherStats& get_stats() const { return stats; }
+
+    void clear();
+
+private:
+    // Reload per-type tables when the registry changes
+    void refresh_block_tables();
+    void update_atlas_cell();
+
+    // Rows of meshed chunks whose vertices read smooth corners that changed this frame
+    void mark_smooth_light_changes();
+
+    // Drop meshes of chunks that are no longer loaded, queue chunks edited
+    // since they were meshed and chunks without a mesh
+    void collect_dirty_chunks();
+
+    // Rows of a mesh that no longer match its chunk
+    uint32_t get_stale_rows(const Chunk2D& chunk, const ChunkMeshData& mesh) const;
+
+    // Quads of rows first_row..last_row of one layer, recording where each row starts
+    void emit_rows(const Chunk2D& chunk, bool background, int first_row, int last_row,
+                   const uint8_t* corner_light, ChunkMeshData& out) const;
+
+    // Light at the 33x33 tile corners of a chunk (row-major)
+    void gather_corner_light(const Chunk2D& chunk, uint8_t* out) const;
+
+    inline bool occludes(uint16_t type_id) const {
+        return type_id < occludes_table.size() && occludes_table[type_id] != 0;
+    }
+};
+
+#endif // CHUNK_MESHER_H
@@ -0,0 +1,966 @@
+#include "lighting_2d.h"
+#include <algorithm>
+#include <chrono>
+
+using namespace godot;
+
+// Final tile light from its sky and block light (underground never goes fully black)
+static inline uint8_t combine_light(uint8_t sky, uint8_t block) {
+    return std::max(std::max(sky, block), AMBIENT_LIGHT_UNDERGROUND);
+}
+
+// Block light planes seen by the flood fill. Both expose the same per-channel
+// operations, so one fill serves the monochrome and the packed RGB layout.
+struct MonoChannel {
+    static constexpr bool COLORED = false;
+
+    static inline uint32_t get(const Chunk2D* chunk, int index) {
+        return chunk->block_light[index / CHUNK_HEIGHT][index % CHUNK_HEIGHT];
+    }
+    static inline void set(Chunk2D* chunk, int index, uint32_t value) {
+        chunk->block_light[index / CHUNK_HEIGHT][index % CHUNK_HEIGHT] = static_cast<uint8_t>(value);
+    }
+    static inline void clear(Chunk2D* chunk) {
+        for (auto& column : chunk->block_light) {
+            column.fill(0);
+        }
+    }
+    static inline uint32_t attenuate(uint32_t light, int loss) {
+        return light > static_cast<uint32_t>(loss) ? light - loss : 0;
+    }
+    static inline uint32_t merge(uint32_t a, uint32_t b) { return std::max(a, b); }
+    // Channels of light that are dimmer than reference (those came through the removed tile)
+    static inline uint32_t dimmer(uint32_t light, uint32_t reference) { return light < reference ? light : 0; }
+    static inline uint8_t intensity(uint32_t light) { return static_cast<uint8_t>(light); }
+};
+
+struct ColorChannel {
+    static constexpr bool COLORED = true;
+
+    static inline uint32_t get(const Chunk2D* chunk, int index) {
+        return chunk->color_light ? chunk->color_light->block_light[index / CHUNK_HEIGHT][index % CHUNK_HEIGHT] : 0;
+    }
+    static inline void set(Chunk2D* chunk, int index, uint32_t value) {
+        int x = index / CHUNK_HEIGHT;
+        int y = index % CHUNK_HEIGHT;
+        chunk->ensure_color_light().block_light[x][y] = value;
+        chunk->block_light[x][y] = PackedLight::intensity(value);
+    }
+    static inline void clear(Chunk2D* chunk) {
+        chunk->ensure_color_light().clear();
+        MonoChannel::clear(chunk);
+    }
+    static inline uint32_t attenuate(uint32_t light, int loss) {
+        return PackedLight::sub_sat(light, PackedLight::splat(static_cast<uint8_t>(std::min(loss, 255))));
+    }
+    static inline uint32_t merge(uint32_t a, uint32_t b) { return PackedLight::max(a, b); }
+    static inline uint32_t dimmer(uint32_t light, uint32_t reference) {
+        return light & PackedLight::nonzero_mask(PackedLight::sub_sat(reference, light));
+    }
+    static inline uint8_t intensity(uint32_t light) { return PackedLight::intensity(light); }
+};
+
+LightingSystem::LightingSystem(ChunkManager* chunks, BlockRegistry* registry, ThreadPool* pool)
+    : chunk_manager(chunks)
+    , block_registry(registry)
+    , thread_pool(pool)
+    , column_top(WORLD_WIDTH, NO_COLUMN_TOP)
+    , registry_version(0)
+    , colored_light(false)
+    , rebuild_budget(LIGHT_REBUILD_CHUNK_BUDGET)
+    , focus_tile_x(0)
+{
+    for (int i = 0; i < LIQUID_TYPE_COUNT; i++) {
+        liquid_emission[i] = 0;
+        liquid_emission_color[i] = 0;
+    }
+    set_liquid_emission(LAVA, LAVA_LIGHT_EMISSION, Color(1.0, 0.55, 0.2));
+
+    // A torch lights roughly a 16 tile diamond; grown once, reused afterwards
+    removal_queue.reserve(4096);
+    spread_queue.reserve(4096);
+
+    const int workers = thread_pool ? thread_pool->get_worker_count() : 1;
+    worker_queues.resize(workers);
+    worker_nodes.resize(workers);
+    for (std::vector<LightNode>& queue : worker_queues) {
+        queue.reserve(CHUNK_SIZE);
+    }
+}
+
+void LightingSystem::update() {
+    refresh_block_tables();
+
+    dirty_chunks.clear();
+    for (const auto& pair : chunk_manager->get_all_chunks()) {
+        if (pair.second->dirty_lighting) {
+            dirty_chunks.push_back(pair.first);
+        }
+    }
+    if (dirty_chunks.empty()) {
+        stats.chunks_pending = 0;
+        return;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    select_rebuild_batch();
+    stats.chunks_rebuilt = dirty_chunks.size();
+    stats.columns_relit = 0;
+    stats.cells_relit = 0;
+    stats.light_nodes = 0;
+    stats.border_passes = 0;
+
+    // Block light first; the sky pass below rewrites the final light of every dirty tile
+    if (colored_light) {
+        rebuild_block_light<ColorChannel>();
+    } else {
+        rebuild_block_light<MonoChannel>();
+    }
+    relight_sky_groups();
+
+    stats.update_usec = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count());
+}
+
+void LightingSystem::select_rebuild_batch() {
+    const int focus_chunk_x = WorldGrid::chunk_x(focus_tile_x);
+    auto column_distance = [focus_chunk_x](int chunk_x) {
+        int distance = std::abs(chunk_x - focus_chunk_x);
+        return std::min(distance, CHUNKS_HORIZONTAL - distance);
+    };
+
+    // Group by chunk column (nearest the focus first), the chunk nearest the sky first
+    std::sort(dirty_chunks.begin(), dirty_chunks.end(), [&column_distance](const Vector2i& a, const Vector2i& b) {
+        int distance_a = column_distance(a.x);
+        int distance_b = column_distance(b.x);
+        if (distance_a != distance_b) {
+            return distance_a < distance_b;
+        }
+        return a.x != b.x ? a.x < b.x : a.y * DOWN_Y < b.y * DOWN_Y;
+    });
+
+    // Whole columns only - the sky pass walks each one from the top; at least one column per update
+    column_groups.clear();
+    size_t group_start = 0;
+    while (group_start < dirty_chunks.size()) {
+        size_t group_end = group_start;
+        while (group_end < dirty_chunks.size() && dirty_chunks[group_end].x == dirty_chunks[group_start].x) {
+            group_end++;
+        }
+        if (group_start > 0 && group_end > rebuild_budget) {
+            break;
+        }
+        column_groups.push_back(std::make_pair(group_start, group_end));
+        group_start = group_end;
+    }
+
+    stats.chunks_pending = dirty_chunks.size() - group_start;
+    dirty_chunks.resize(group_start);
+}
+
+void LightingSystem::relight_sky_groups() {
+    // Tile rows of a chunk nearest to and farthest from the sky
+    auto near_row = [](int chunk_y) { return WorldGrid::origin_y(chunk_y) + (DOWN_Y > 0 ? 0 : CHUNK_HEIGHT - 1); };
+    auto far_row = [](int chunk_y) { return WorldGrid::origin_y(chunk_y) + (DOWN_Y > 0 ? CHUNK_HEIGHT - 1 : 0); };
+
+    // Columns only read and write chunks of their own chunk column
+    auto relight_group = [&](size_t group, int) {
+        const size_t group_start = column_groups[group].first;
+        const size_t group_end = column_groups[group].second;
+        const int chunk_x = dirty_chunks[group_start].x;
+        const int first_y = near_row(dirty_chunks[group_start].y);
+        const int last_y = far_row(dirty_chunks[group_end - 1].y);
+
+        // One walk per column covers every dirty chunk stacked in it
+        size_t cells = 0;
+        for (int local_x = 0; local_x < CHUNK_WIDTH; local_x++) {
+            int tile_x = WorldGrid::origin_x(chunk_x) + local_x;
+            for (size_t i = group_start; i < group_end; i++) {
+                refresh_column_top(tile_x, near_row(dirty_chunks[i].y), far_row(dirty_chunks[i].y));
+            }
+            cells += relight_column(tile_x, first_y, last_y);
+        }
+        group_cells[group] = cells;
+
+        for (size_t i = group_start; i < group_end; i++) {
+            Chunk2D* chunk = chunk_manager->get_chunk(dirty_chunks[i]);
+            chunk->dirty_lighting = false;
+            chunk->mark_all_edited(CHUNK_LAYER_LIGHT);
+        }
+    };
+
+    group_cells.assign(column_groups.size(), 0);
+    if (thread_pool && dirty_chunks.size() >= LIGHT_PARALLEL_MIN_CHUNKS) {
+        thread_pool->parallel_for(column_groups.size(), relight_group);
+    } else {
+        for (size_t group = 0; group < column_groups.size(); group++) {
+            relight_group(group, 0);
+        }
+    }
+
+    stats.columns_relit += column_groups.size() * CHUNK_WIDTH;
+    for (size_t cells : group_cells) {
+        stats.cells_relit += cells;
+    }
+}
+
+void LightingSystem::apply_block_events(const BlockChangeEvent* events, size_t count) {
+    if (count == 0) {
+        return;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    refresh_block_tables();
+    stats.chunks_rebuilt = 0;
+    stats.columns_relit = 0;
+    stats.cells_relit = 0;
+    stats.light_nodes = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        // Background walls don't shade the sky; type-only updates (regeneration) change nothing
+        if (events[i].is_background || events[i].old_type == events[i].new_type) {
+            continue;
+        }
+        on_block_changed(events[i].get_tile_pos());
+    }
+
+    stats.update_usec = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count());
+}
+
+void LightingSystem::on_block_changed(Vector2i tile_pos) {
+    tile_pos = WorldCoords::wrap_tile_x(tile_pos);
+    if (!WorldCoords::is_valid_y(tile_pos.y)) {
+        return;
+    }
+
+    refresh_column_top(tile_pos.x, tile_pos.y, tile_pos.y);
+    stats.cells_relit += relight_column(tile_pos.x, tile_pos.y, tile_pos.y);
+    stats.columns_relit++;
+    on_light_source_changed(tile_pos);
+}
+
+void LightingSystem::apply_liquid_changes(const LiquidCellChange* changes, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        if (changes[i].type < LIQUID_TYPE_COUNT && liquid_emission[changes[i].type] > 0) {
+            on_light_source_changed(changes[i].tile_pos);
+        }
+    }
+}
+
+void LightingSystem::on_light_source_changed(Vector2i tile_pos) {
+    tile_pos = WorldCoords::wrap_tile_x(tile_pos);
+    if (!WorldCoords::is_valid_y(tile_pos.y)) {
+        return;
+    }
+    Chunk2D* chunk = chunk_manager->get_chunk(WorldCoords::tile_to_chunk(tile_pos));
+    if (!chunk) {
+        return;
+    }
+
+    if (colored_light) {
+        relight_source<ColorChannel>(chunk, WorldCoords::tile_to_local(tile_pos));
+    } else {
+        relight_source<MonoChannel>(chunk, WorldCoords::tile_to_local(tile_pos));
+    }
+}
+
+void LightingSystem::set_liquid_emission(LiquidType type, uint8_t emission, const Color& color) {
+    if (type > LIQUID_NONE && type < LIQUID_TYPE_COUNT) {
+        liquid_emission[type] = emission;
+        liquid_emission_color[type] = PackedLight::from_color(color, emission);
+    }
+}
+
+void LightingSystem::set_colored_light(bool enabled) {
+    if (colored_light == enabled) {
+        return;
+    }
+    colored_light = enabled;
+
+    if (!enabled) {
+        for (const auto& pair : chunk_manager->get_all_chunks()) {
+            pair.second->color_light.reset();
+        }
+    }
+    for (const auto& pair : chunk_manager->get_all_chunks()) {
+        pair.second->dirty_lighting = true;
+    }
+}
+
+void LightingSystem::invalidate_all() {
+    for (const auto& pair : chunk_manager->get_all_chunks()) {
+        pair.second->dirty_lighting = true;
+    }
+    std::fill(column_top.begin(), column_top.end(), NO_COLUMN_TOP);
+}
+
+uint8_t LightingSystem::get_sky_light(Vector2i tile_pos) const {
+    tile_pos = WorldCoords::wrap_tile_x(tile_pos);
+    if (!WorldCoords::is_valid_y(tile_pos.y)) {
+        return depth_of(tile_pos.y) < 0 ? MAX_LIGHT_LEVEL : MIN_LIGHT_LEVEL;
+    }
+
+    const Chunk2D* chunk = chunk_manager->get_chunk(WorldCoords::tile_to_chunk(tile_pos));
+    if (!chunk) {
+        return MIN_LIGHT_LEVEL;
+    }
+    Vector2i local_pos = WorldCoords::tile_to_local(tile_pos);
+    return chunk->sky_light[local_pos.x][local_pos.y];
+}
+
+uint8_t LightingSystem::get_block_light(Vector2i tile_pos) const {
+    tile_pos = WorldCoords::wrap_tile_x(tile_pos);
+    if (!WorldCoords::is_valid_y(tile_pos.y)) {
+        return MIN_LIGHT_LEVEL;
+    }
+
+    const Chunk2D* chunk = chunk_manager->get_chunk(WorldCoords::tile_to_chunk(tile_pos));
+    if (!chunk) {
+        return MIN_LIGHT_LEVEL;
+    }
+    Vector2i local_pos = WorldCoords::tile_to_local(tile_pos);
+    return chunk->block_light[local_pos.x][local_pos.y];
+}
+
+uint8_t LightingSystem::get_light(Vector2i tile_pos) const {
+    tile_pos = WorldCoords::wrap_tile_x(tile_pos);
+    if (!WorldCoords::is_valid_y(tile_pos.y)) {
+        return depth_of(tile_pos.y) < 0 ? MAX_LIGHT_LEVEL : MIN_LIGHT_LEVEL;
+    }
+
+    const Chunk2D* chunk = chunk_manager->get_chunk(WorldCoords::tile_to_chunk(tile_pos));
+    return chunk ? chunk->get_light(WorldCoords::tile_to_local(tile_pos)) : MIN_LIGHT_LEVEL;
+}
+
+void LightingSystem::build_light_texture(const Rect2i& tile_region, PackedByteArray& out) const {
+    const int width = std::max(tile_region.size.x, 0);
+    const int height = std::max(tile_region.size.y, 0);
+    const int64_t byte_count = static_cast<int64_t>(width) * height * 3;
+    if (out.size() != byte_count) {
+        out.resize(byte_count);
+    }
+    if (byte_count == 0) {
+        return;
+    }
+
+    const uint32_t ambient = PackedLight::splat(AMBIENT_LIGHT_UNDERGROUND);
+    const int stride = width * 3;
+    uint8_t* texels = out.ptrw();
+
+    // Walk chunk by chunk in the planes' column-major order; the texture writes
+    // stay within the 32 rows of the current band
+    int row = 0;
+    while (row < height) {
+        const int tile_y = tile_region.position.y + row;
+        uint8_t* band = texels + static_cast<int64_t>(row) * stride;
+
+        if (!WorldCoords::is_valid_y(tile_y)) {
+            // Open sky above the world, darkness below it
+            std::fill(band, band + stride, depth_of(tile_y) < 0 ? MAX_LIGHT_LEVEL : MIN_LIGHT_LEVEL);
+            row++;
+            continue;
+        }
+
+        const int chunk_y = WorldGrid::chunk_y(tile_y);
+        const int local_y_start = WorldGrid::local_y(tile_y);
+        const int rows = std::min(CHUNK_HEIGHT - local_y_start, height - row);
+
+        int tile_x = WorldCoords::wrap_x(tile_region.position.x);
+        int column = 0;
+        while (column < width) {
+            const int local_x_start = WorldGrid::local_x(tile_x);
+            const int span = std::min(CHUNK_WIDTH - local_x_start, width - column);
+            const Chunk2D* chunk = chunk_manager->get_chunk(Vector2i(WorldGrid::chunk_x(tile_x), chunk_y));
+            const ChunkColorLight* color = chunk ? chunk->color_light.get() : nullptr;
+
+            for (int i = 0; i < span; i++) {
+                const int local_x = local_x_start + i;
+                uint8_t* dst = band + (column + i) * 3;
+
+                for (int j = 0; j < rows; j++, dst += stride) {
+                    const int local_y = local_y_start + j;
+                    uint32_t light = 0;
+                    if (chunk) {
+                        // Sky is white; block light is tinted in colored mode
+                        uint32_t block = color ? color->block_light[local_x][local_y]
+                                               : PackedLight::splat(chunk->block_light[local_x][local_y]);
+                        light = PackedLight::max(PackedLight::splat(chunk->sky_light[local_x][local_y]), block);
+                        light = PackedLight::max(light, ambient);
+                    }
+                    dst[0] = PackedLight::red(light);
+                    dst[1] = PackedLight::green(light);
+                    dst[2] = PackedLight::blue(light);
+                }
+            }
+
+            column += span;
+            tile_x = WorldCoords::wrap_x(tile_x + span);
+        }
+        row += rows;
+    }
+}
+
+void LightingSystem::clear() {
+    std::fill(column_top.begin(), column_top.end(), NO_COLUMN_TOP);
+    stats = LightingStats();
+}
+
+void LightingSystem::refresh_block_tables() {
+    if (!opacity_table.empty() && registry_version == block_registry->get_version()) {
+        return;
+    }
+    bool had_table = !opacity_table.empty();
+    registry_version = block_registry->get_version();
+
+    const size_t type_count = static_cast<size_t>(block_registry->get_max_block_id()) + 1;
+    opacity_table.assign(type_count, 0);
+    emission_table.assign(type_count, 0);
+    emission_color_table.assign(type_count, 0);
+    for (const auto& pair : block_registry->get_all_blocks()) {
+        if (pair.first < type_count) {
+            opacity_table[pair.first] = pair.second.light_opacity;
+            emission_table[pair.first] = pair.second.light_emission;
+            emission_color_table[pair.first] = PackedLight::from_color(pair.second.light_color, pair.second.light_emission);
+        }
+    }
+    opacity_table[0] = 0;
+    emission_table[0] = 0;
+    emission_color_table[0] = 0;
+
+    // Opacities / emissions changed under already lit chunks
+    if (had_table) {
+        invalidate_all();
+    }
+}
+
+void LightingSystem::refresh_column_top(int tile_x, int from_y, int to_y) {
+    int32_t& top = column_top[tile_x];
+    int top_depth = depth_of(top);
+    if (top_depth < depth_of(from_y)) {
+        return;  // Edits below the top can't move it
+    }
+
+    // Highest opaque tile inside the changed span
+    int found = find_column_top(tile_x, from_y);
+    int found_depth = depth_of(found);
+    if (found_depth <= depth_of(to_y) && found_depth < top_depth) {
+        top = found;
+        return;
+    }
+
+    // The old top was inside the span and is gone - look further down
+    if (top_depth <= depth_of(to_y) && found != top) {
+        top = found;
+    }
+}
+
+int LightingSystem::find_column_top(int tile_x, int from_y) const {
+    const int chunk_x = WorldGrid::chunk_x(tile_x);
+    const int local_x = WorldGrid::local_x(tile_x);
+    int chunk_y = -1;
+    const Chunk2D* chunk = nullptr;
+
+    for (int depth = std::max(depth_of(from_y), 0); depth < WORLD_HEIGHT; depth++) {
+        int y = depth_of(depth);
+        if (WorldGrid::chunk_y(y) != chunk_y) {
+            chunk_y = WorldGrid::chunk_y(y);
+            chunk = chunk_manager->get_chunk(Vector2i(chunk_x, chunk_y));
+            if (!chunk) {
+                break;
+            }
+        }
+        if (opacity_of(chunk->foreground.get_type(local_x, WorldGrid::local_y(y))) > 0) {
+            return y;
+        }
+    }
+    return NO_COLUMN_TOP;
+}
+
+uint8_t LightingSystem::incoming_sky(int tile_x, int tile_y) const {
+    if (depth_of(tile_y) <= 0) {
+        return MAX_LIGHT_LEVEL;
+    }
+
+    int above_y = tile_y - DOWN_Y;
+    const Chunk2D* chunk = chunk_manager->get_chunk(Vector2i(WorldGrid::chunk_x(tile_x), WorldGrid::chunk_y(above_y)));
+    if (!chunk) {
+        // Unknown terrain above: open sky unless an opaque tile is known to be there
+        return depth_of(tile_y) <= depth_of(column_top[tile_x]) ? MAX_LIGHT_LEVEL : MIN_LIGHT_LEVEL;
+    }
+
+    int local_x = WorldGrid::local_x(tile_x);
+    int local_y = WorldGrid::local_y(above_y);
+    int sky = chunk->sky_light[local_x][local_y] - opacity_of(chunk->foreground.get_type(local_x, local_y));
+    return static_cast<uint8_t>(std::max(sky, 0));
+}
+
+size_t LightingSystem::relight_column(int tile_x, int start_y, int force_until_y) {
+    tile_x = WorldCoords::wrap_x(tile_x);
+
+    const int chunk_x = WorldGrid::chunk_x(tile_x);
+    const int local_x = WorldGrid::local_x(tile_x);
+    const int force_depth = depth_of(force_until_y);
+    int start_depth = std::max(depth_of(start_y), 0);
+    int sky = incoming_sky(tile_x, depth_of(start_depth));
+
+    int chunk_y = -1;
+    Chunk2D* chunk = nullptr;
+    int changed_from = CHUNK_HEIGHT;    // Local rows changed in the current chunk
+    int changed_to = -1;
+    size_t cells = 0;
+
+    for (int depth = start_depth; depth < WORLD_HEIGHT; depth++) {
+        int y = depth_of(depth);
+        if (WorldGrid::chunk_y(y) != chunk_y) {
+            if (changed_to >= 0) {
+                chunk->mark_edited(CHUNK_LAYER_LIGHT, local_x, changed_from, local_x, changed_to);
+            }
+            changed_from = CHUNK_HEIGHT;
+            changed_to = -1;
+            chunk_y = WorldGrid::chunk_y(y);
+            chunk = chunk_manager->get_chunk(Vector2i(chunk_x, chunk_y));
+            if (!chunk) {
+                return cells;
+            }
+        }
+
+        int local_y = WorldGrid::local_y(y);
+        uint8_t& stored = chunk->sky_light[local_x][local_y];
+        uint8_t value = static_cast<uint8_t>(sky);
+
+        // Below the edit, an unchanged tile means the rest of the column is unchanged
+        if (depth > force_depth && stored == value) {
+            break;
+        }
+
+        if (stored != value) {
+            changed_from = std::min(changed_from, local_y);
+            changed_to = std::max(changed_to, local_y);
+        }
+        stored = value;
+        chunk->lighting[local_x][local_y] = combine_light(value, chunk->block_light[local_x][local_y]);
+        cells++;
+
+        sky = std::max(sky - opacity_of(chunk->foreground.get_type(local_x, local_y)), 0);
+    }
+
+    if (changed_to >= 0) {
+        chunk->mark_edited(CHUNK_LAYER_LIGHT, local_x, changed_from, local_x, changed_to);
+    }
+    return cells;
+}
+
+
+uint8_t LightingSystem::emission_at(const Chunk2D* chunk, int local_x, int local_y) const {
+    const uint16_t type_id = chunk->foreground.get_type(local_x, local_y);
+    uint8_t emission = type_id < emission_table.size() ? emission_table[type_id] : 0;
+
+    if (chunk->liquid) {
+        int index = ChunkLiquidGrid::index_of(Vector2i(local_x, local_y));
+        uint8_t glow = chunk->liquid->level[index] > 0.0f ? liquid_emission[chunk->liquid->type[index]] : 0;
+        emission = std::max(emission, glow);
+    }
+    return emission;
+}
+
+uint32_t LightingSystem::color_emission_at(const Chunk2D* chunk, int local_x, int local_y) const {
+    const uint16_t type_id = chunk->foreground.get_type(local_x, local_y);
+    uint32_t emission = type_id < emission_color_table.size() ? emission_color_table[type_id] : 0;
+
+    if (chunk->liquid) {
+        int index = ChunkLiquidGrid::index_of(Vector2i(local_x, local_y));
+        if (chunk->liquid->level[index] > 0.0f) {
+            emission = PackedLight::max(emission, liquid_emission_color[chunk->liquid->type[index]]);
+        }
+    }
+    return emission;
+}
+
+template <typename Channel>
+uint32_t LightingSystem::source_at(const Chunk2D* chunk, int local_x, int local_y) const {
+    return Channel::COLORED ? color_emission_at(chunk, local_x, local_y) : emission_at(chunk, local_x, local_y);
+}
+
+template <typename Channel>
+bool LightingSystem::has_sources(const Chunk2D* chunk) const {
+    if (chunk->liquid) {
+        return true;
+    }
+    return Channel::COLORED ? chunk->foreground_occupancy.has_any_type(emission_color_table)
+                            : chunk->foreground_occupancy.has_any_type(emission_table);
+}
+
+bool LightingSystem::neighbor_node(const LightNode& node, int direction, LightNode& out) const {
+    static const int offset_x[4] = { -1, 1, 0, 0 };
+    static const int offset_y[4] = { 0, 0, -1, 1 };
+
+    int x = node.index / CHUNK_HEIGHT + offset_x[direction];
+    int y = node.index % CHUNK_HEIGHT + offset_y[direction];
+    out.chunk = node.chunk;
+    out.level = 0;
+
+    if (x < 0 || x >= CHUNK_WIDTH || y < 0 || y >= CHUNK_HEIGHT) {
+        // Next chunk over (neighbor pointers wrap X around the world)
+        Vector2i step((x >= CHUNK_WIDTH) - (x < 0), (y >= CHUNK_HEIGHT) - (y < 0));
+        out.chunk = node.chunk->get_neighbor(step.x, step.y);
+        if (!out.chunk) {
+            return false;
+        }
+        x -= step.x * CHUNK_WIDTH;
+        y -= step.y * CHUNK_HEIGHT;
+    }
+
+    out.index = static_cast<uint16_t>(x * CHUNK_HEIGHT + y);
+    return true;
+}
+
+template <typename Channel>
+void LightingSystem::write_block_light(Chunk2D* chunk, int index, uint32_t value) {
+    int x = index / CHUNK_HEIGHT;
+    int y = index % CHUNK_HEIGHT;
+    Channel::set(chunk, index, value);
+    chunk->lighting[x][y] = combine_light(chunk->sky_light[x][y], Channel::intensity(value));
+    chunk->mark_edited(CHUNK_LAYER_LIGHT, x, y);
+}
+
+template <typename Channel>
+void LightingSystem::relight_source(Chunk2D* chunk, Vector2i local_pos) {
+    LightNode node;
+    node.chunk = chunk;
+    node.index = static_cast<uint16_t>(local_pos.x * CHUNK_HEIGHT + local_pos.y);
+    node.level = Channel::get(chunk, node.index);
+
+    // Clear everything lit through this tile (re-seeds any source inside the cleared area)
+    if (node.level > 0) {
+        write_block_light<Channel>(chunk, node.index, 0);
+        removal_queue.push_back(node);
+        run_light_removal<Channel>();
+    }
+
+    uint32_t current = Channel::get(chunk, node.index);
+    uint32_t lit = Channel::merge(current, source_at<Channel>(chunk, local_pos.x, local_pos.y));
+    if (lit != current) {
+        write_block_light<Channel>(chunk, node.index, lit);
+        spread_queue.push_back(node);
+    }
+
+    // Neighbors' light may pass through the tile now
+    for (int direction = 0; direction < 4; direction++) {
+        LightNode next;
+        if (neighbor_node(node, direction, next) && Channel::get(next.chunk, next.index) > 0) {
+            spread_queue.push_back(next);
+        }
+    }
+    run_light_spread<Channel>();
+}
+
+template <typename Channel>
+void LightingSystem::run_light_removal() {
+    // Index loop - the queue grows while it is drained
+    for (size_t head = 0; head < removal_queue.size(); head++) {
+        LightNode node = removal_queue[head];
+        stats.light_nodes++;
+
+        for (int direction = 0; direction < 4; direction++) {
+            LightNode next;
+            if (!neighbor_node(node, direction, next)) {
+                continue;
+            }
+
+            uint32_t level = Channel::get(next.chunk, next.index);
+            if (level == 0) {
+                continue;
+            }
+
+            // Channels dimmer than the removed light came through it - clear them and keep going
+            uint32_t removed = Channel::dimmer(level, node.level);
+            if (removed != 0) {
+                write_block_light<Channel>(next.chunk, next.index, level - removed);
+                next.level = removed;
+                removal_queue.push_back(next);
+            }
+
+            // Channels lit from elsewhere refill the cleared area
+            if (level != removed) {
+                spread_queue.push_back(next);
+            }
+        }
+
+        // A light source inside the cleared area shines again
+        uint32_t emission = source_at<Channel>(node.chunk, node.index / CHUNK_HEIGHT, node.index % CHUNK_HEIGHT);
+        if (emission > 0) {
+            write_block_light<Channel>(node.chunk, node.index,
+                                       Channel::merge(Channel::get(node.chunk, node.index), emission));
+            spread_queue.push_back(node);
+        }
+    }
+    removal_queue.clear();
+}
+
+template <typename Channel>
+void LightingSystem::run_light_spread() {
+    for (size_t head = 0; head < spread_queue.size(); head++) {
+        LightNode node = spread_queue[head];
+        stats.light_nodes++;
+
+        int x = node.index / CHUNK_HEIGHT;
+        int y = node.index % CHUNK_HEIGHT;
+
+        // Light leaving a tile loses the falloff plus the tile's opacity (sources shine out regardless)
+        int opacity = source_at<Channel>(node.chunk, x, y) > 0 ? 0 : opacity_of(node.chunk->foreground.get_type(x, y));
+        uint32_t out = Channel::attenuate(Channel::get(node.chunk, node.index), LIGHT_FALLOFF_PER_TILE + opacity);
+        if (out == 0) {
+            continue;
+        }
+
+        for (int direction = 0; direction < 4; direction++) {
+            LightNode next;
+            if (!neighbor_node(node, direction, next)) {
+                continue;
+            }
+            uint32_t current = Channel::get(next.chunk, next.index);
+            uint32_t lit = Channel::merge(current, out);
+            if (lit != current) {
+                write_block_light<Channel>(next.chunk, next.index, lit);
+                spread_queue.push_back(next);
+            }
+        }
+    }
+    spread_queue.clear();
+}
+
+template <typename Channel>
+void LightingSystem::rebuild_block_light() {
+    if (thread_pool && dirty_chunks.size() >= LIGHT_PARALLEL_MIN_CHUNKS) {
+        rebuild_block_light_parallel<Channel>();
+        return;
+    }
+
+    for (const Vector2i& chunk_pos : dirty_chunks) {
+        Channel::clear(chunk_manager->get_chunk(chunk_pos));
+    }
+
+    static const Vector2i sides[4] = { Vector2i(-1, 0), Vector2i(1, 0), Vector2i(0, -1), Vector2i(0, 1) };
+
+    for (const Vector2i& chunk_pos : dirty_chunks) {
+        Chunk2D* chunk = chunk_manager->get_chunk(chunk_pos);
+
+        // Sources inside the chunk (none to look for if its histogram has no emitter)
+        const bool scan_sources = has_sources<Channel>(chunk);
+        for (int x = 0; scan_sources && x < CHUNK_WIDTH; x++) {
+            for (int y = 0; y < CHUNK_HEIGHT; y++) {
+                uint32_t emission = source_at<Channel>(chunk, x, y);
+                if (emission > 0) {
+                    int index = x * CHUNK_HEIGHT + y;
+                    Channel::set(chunk, index, emission);
+                    spread_queue.push_back({ chunk, static_cast<uint16_t>(index), 0 });
+                }
+            }
+        }
+
+        // Light already in clean neighbors flows back across the border
+        for (const Vector2i& side : sides) {
+            Chunk2D* neighbor = chunk->get_neighbor(side.x, side.y);
+            if (!neighbor || neighbor->dirty_lighting) {
+                continue;
+            }
+            for (int i = 0; i < CHUNK_WIDTH; i++) {
+                int x = side.x < 0 ? CHUNK_WIDTH - 1 : (side.x > 0 ? 0 : i);
+                int y = side.y < 0 ? CHUNK_HEIGHT - 1 : (side.y > 0 ? 0 : i);
+                int index = x * CHUNK_HEIGHT + y;
+                if (Channel::get(neighbor, index) > 0) {
+                    spread_queue.push_back({ neighbor, static_cast<uint16_t>(index), 0 });
+                }
+            }
+        }
+    }
+
+    run_light_spread<Channel>();
+}
+
+template <typename Channel>
+uint32_t LightingSystem::outgoing_light(const Chunk2D* chunk, int index) const {
+    int x = index / CHUNK_HEIGHT;
+    int y = index % CHUNK_HEIGHT;
+    int opacity = source_at<Channel>(chunk, x, y) > 0 ? 0 : opacity_of(chunk->foreground.get_type(x, y));
+    return Channel::attenuate(Channel::get(chunk, index), LIGHT_FALLOFF_PER_TILE + opacity);
+}
+
+template <typename Channel>
+size_t LightingSystem::spread_in_chunk(std::vector<LightNode>& queue) const {
+    for (size_t head = 0; head < queue.size(); head++) {
+        LightNode node = queue[head];
+        uint32_t out = outgoing_light<Channel>(node.chunk, node.index);
+        if (out == 0) {
+            continue;
+        }
+
+        auto raise = [&](int index) {
+            uint32_t current = Channel::get(node.chunk, index);
+            uint32_t lit = Channel::merge(current, out);
+            if (lit != current) {
+                write_block_light<Channel>(node.chunk, index, lit);
+                queue.push_back({ node.chunk, static_cast<uint16_t>(index), 0 });
+            }
+        };
+
+        int x = node.index / CHUNK_HEIGHT;
+        int y = node.index % CHUNK_HEIGHT;
+        if (x > 0) raise(node.index - CHUNK_HEIGHT);
+        if (x < CHUNK_WIDTH - 1) raise(node.index + CHUNK_HEIGHT);
+        if (y > 0) raise(node.index - 1);
+        if (y < CHUNK_HEIGHT - 1) raise(node.index + 1);
+    }
+
+    size_t nodes = queue.size();
+    queue.clear();
+    return nodes;
+}
+
+// Local index of tile i along a chunk side (0 left, 1 right, 2 up, 3 down - same order as neighbor_node)
+static inline int edge_index(int side, int i) {
+    switch (side) {
+        case 0: return i;
+        case 1: return (CHUNK_WIDTH - 1) * CHUNK_HEIGHT + i;
+        case 2: return i * CHUNK_HEIGHT;
+        default: return i * CHUNK_HEIGHT + CHUNK_HEIGHT - 1;
+    }
+}
+
+template <typename Channel>
+void LightingSystem::rebuild_block_light_parallel() {
+    static const Vector2i sides[4] = { Vector2i(-1, 0), Vector2i(1, 0), Vector2i(0, -1), Vector2i(0, 1) };
+    const size_t count = dirty_chunks.size();
+
+    batch_index.clear();
+    for (size_t i = 0; i < count; i++) {
+        batch_index[dirty_chunks[i]] = static_cast<int>(i);
+    }
+
+    batch.resize(count);
+    for (size_t i = 0; i < count; i++) {
+        BatchChunk& entry = batch[i];
+        entry.chunk = chunk_manager->get_chunk(dirty_chunks[i]);
+        for (int side = 0; side < 4; side++) {
+            entry.neighbor_batch[side] = -1;
+            entry.neighbor_clean[side] = nullptr;
+
+            // Neighbor pointers wrap X; the neighbor's chunk_position is the batch key
+            Chunk2D* neighbor = entry.chunk->get_neighbor(sides[side].x, sides[side].y);
+            if (!neighbor) {
+                continue;
+            }
+            auto it = batch_index.find(neighbor->chunk_position);
+            if (it != batch_index.end()) {
+                entry.neighbor_batch[side] = it->second;
+            } else if (!neighbor->dirty_lighting) {
+                entry.neighbor_clean[side] = neighbor;
+            }
+        }
+    }
+
+    std::fill(worker_nodes.begin(), worker_nodes.end(), 0);
+    edge_light.resize(count * 4 * CHUNK_WIDTH);
+    batch_changed.assign(count, 1);
+
+    // Phase 1: every chunk from its own sources
+    thread_pool->parallel_for(count, [this](size_t i, int worker) {
+        Chunk2D* chunk = batch[i].chunk;
+        std::vector<LightNode>& queue = worker_queues[worker];
+        Channel::clear(chunk);
+
+        const bool scan_sources = has_sources<Channel>(chunk);
+        for (int x = 0; scan_sources && x < CHUNK_WIDTH; x++) {
+            for (int y = 0; y < CHUNK_HEIGHT; y++) {
+                uint32_t emission = source_at<Channel>(chunk, x, y);
+                if (emission > 0) {
+                    int index = x * CHUNK_HEIGHT + y;
+                    Channel::set(chunk, index, emission);
+                    queue.push_back({ chunk, static_cast<uint16_t>(index), 0 });
+                }
+            }
+        }
+        worker_nodes[worker] += spread_in_chunk<Channel>(queue);
+    });
+
+    // Phase 2: exchange border light until no chunk changes. Each round reads
+    // edge snapshots only, so every chunk is written by one worker at a time.
+    bool first_pass = true;
+    bool any_changed = true;
+    while (any_changed) {
+        stats.border_passes++;
+
+        thread_pool->parallel_for(count, [this](size_t i, int) {
+            if (!batch_changed[i]) {
+                return;
+            }
+            uint32_t* out = &edge_light[i * 4 * CHUNK_WIDTH];
+            for (int side = 0; side < 4; side++) {
+                for (int k = 0; k < CHUNK_WIDTH; k++) {
+                    out[side * CHUNK_WIDTH + k] = outgoing_light<Channel>(batch[i].chunk, edge_index(side, k));
+                }
+            }
+        });
+
+        // Which chunks border a chunk that changed last round (their snapshot is new)
+        std::vector<uint8_t> previous = batch_changed;
+        thread_pool->parallel_for(count, [this, &previous, first_pass](size_t i, int worker) {
+            const BatchChunk& entry = batch[i];
+            std::vector<LightNode>& queue = worker_queues[worker];
+
+            for (int side = 0; side < 4; side++) {
+                const int neighbor = entry.neighbor_batch[side];
+                const Chunk2D* clean = first_pass ? entry.neighbor_clean[side] : nullptr;
+                if ((neighbor < 0 || !previous[neighbor]) && !clean) {
+                    continue;
+                }
+
+                for (int k = 0; k < CHUNK_WIDTH; k++) {
+                    // The neighbor's opposite edge faces this side
+                    uint32_t incoming = neighbor >= 0
+                        ? edge_light[(neighbor * 4 + (side ^ 1)) * CHUNK_WIDTH + k]
+                        : outgoing_light<Channel>(clean, edge_index(side ^ 1, k));
+                    if (incoming == 0) {
+                        continue;
+                    }
+
+                    int index = edge_index(side, k);
+                    uint32_t current = Channel::get(entry.chunk, index);
+                    uint32_t lit = Channel::merge(current, incoming);
+                    if (lit != current) {
+                        write_block_light<Channel>(entry.chunk, index, lit);
+                        queue.push_back({ entry.chunk, static_cast<uint16_t>(index), 0 });
+                    }
+                }
+            }
+
+            batch_changed[i] = !queue.empty();
+            worker_nodes[worker] += spread_in_chunk<Channel>(queue);
+        });
+
+        first_pass = false;
+        any_changed = std::find(batch_changed.begin(), batch_changed.end(), 1) != batch_changed.end();
+    }
+
+    for (size_t nodes : worker_nodes) {
+        stats.light_nodes += nodes;
+    }
+
+    // Phase 3: light leaving the batch spreads on this thread (same fill as edits)
+    for (size_t i = 0; i < count; i++) {
+        const BatchChunk& entry = batch[i];
+        for (int side = 0; side < 4; side++) {
+            if (entry.neighbor_batch[side] >= 0 || !entry.chunk->get_neighbor(sides[side].x, sides[side].y)) {
+                continue;
+            }
+            for (int k = 0; k < CHUNK_WIDTH; k++) {
+                int index = edge_index(side, k);
+                if (Channel::get(entry.chunk, index) > 0) {
+                    spread_queue.push_back({ entry.chunk, static_cast<uint16_t>(index), 0 });
+                }
+            }
+        }
+    }
+    run_light_spread<Channel>();
+}
@@ -0,0 +1,262 @@
+#ifndef LIGHTING_2D_H
+#define LIGHTING_2D_H
+
+#include "../world/block_data.h"
+#include "../world/world_constants.h"
+#include "../world/chunk_2d.h"
+#include "../world/chunk_color_light.h"
+#include "../core/chunk_manager.h"
+#include "../core/block_registry.h"
+#include "../core/block_events.h"
+#include "../core/liquid_simulation.h"
+#include "../utils/thread_pool.h"
+#include <godot_cpp/variant/vector2i.hpp>
+#include <godot_cpp/variant/rect2i.hpp>
+#include <godot_cpp/variant/color.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <cstdint>
+
+using namespace godot;
+
+// Point light tuning
+constexpr int LIGHT_FALLOFF_PER_TILE = 16;      // Block light lost per tile travelled (torch reach ~16 tiles)
+constexpr uint8_t LAVA_LIGHT_EMISSION = 200;
+
+// Full rebuilds (new / regenerated chunks)
+constexpr size_t LIGHT_REBUILD_CHUNK_BUDGET = 1024;     // Dirty chunks relit per update (whole chunk columns, nearest the view first)
+constexpr size_t LIGHT_PARALLEL_MIN_CHUNKS = 16;        // Smaller batches stay on the calling thread
+
+// Counters from the last lighting update (for debug overlays and profiling)
+struct LightingStats {
+    size_t chunks_rebuilt;      // Dirty chunks relit from scratch
+    size_t columns_relit;       // Column spans walked (full rebuilds + block edits)
+    size_t cells_relit;         // Cells whose skylight was recomputed
+    size_t light_nodes;         // Block light flood-fill nodes processed (removal + spread)
+    size_t chunks_pending;      // Dirty chunks left for later updates (rebuild budget)
+    size_t border_passes;       // Border exchange rounds of the last parallel rebuild
+    uint64_t update_usec;       // Duration of the last update / event batch
+
+    LightingStats()
+        : chunks_rebuilt(0)
+        , columns_relit(0)
+        , cells_relit(0)
+        , light_nodes(0)
+        , chunks_pending(0)
+        , border_passes(0)
+        , update_usec(0)
+    {}
+};
+
+// Column-based skylight
+// Keeps a heightmap of the highest opaque foreground block for every world
+// column. Skylight enters each column at the top edge of the world (the space
+// side DOWN_Y points away from, y = WORLD_HEIGHT - 1) at full strength and
+// loses each block's light_opacity as it passes through. A tile's skylight only depends on the
+// tile above it, so an edit relights its column from the edited tile downwards
+// and stops at the first tile whose value didn't change - mining or placing at
+// the surface touches a handful of cells.
+//
+// Block light (torches, lava) spreads by breadth-first flood fill, losing
+// LIGHT_FALLOFF_PER_TILE per step plus the opacity of the tile it leaves.
+// Changes use the two-queue scheme: a removal pass clears the light that came
+// through the changed tile, then the spread pass refills it from the lights
+// bordering the cleared area. Only the affected radius is touched; the fill
+// crosses chunk borders and the horizontal world wrap.
+//
+// Colored mode (off by default) keeps block light as PackedLight RGB, tinted by
+// BlockDefinition::light_color. The same flood fill runs on the packed values,
+// so all three channels propagate in one pass; block_light then holds the
+// brightest channel for gameplay queries.
+//
+// Full rebuilds run at most LIGHT_REBUILD_CHUNK_BUDGET chunks per update,
+// whole chunk columns nearest the focus (camera) first, so the first frame
+// after world generation lights the view and the rest follows over the next
+// frames. With a thread pool, block light of a batch is solved per chunk in
+// parallel and then reconciled across chunk borders (each round exchanges
+// edge light and refills the chunks it raised) until nothing changes; light
+// leaving the batch is spread serially. The flood fill has a single fixed
+// point, so the result is identical to the serial fill. Skylight columns are
+// independent and run in parallel per chunk column.
+class LightingSystem {
+public:
+    // First row skylight reaches, and the column_top value of a column with no opaque tile
+    static constexpr int SKY_EDGE_Y = DOWN_Y > 0 ? 0 : WORLD_HEIGHT - 1;
+    static constexpr int NO_COLUMN_TOP = DOWN_Y > 0 ? WORLD_HEIGHT : -1;
+    static_assert(SKY_EDGE_Y >= LAYER_SPACE_BOTTOM, "Skylight must enter from the space layer WorldGenerator leaves open");
+
+private:
+    ChunkManager* chunk_manager;
+    BlockRegistry* block_registry;
+    ThreadPool* thread_pool;        // Optional (full rebuilds run serially without it)
+
+    // Highest tile Y with light_opacity > 0 per column (NO_COLUMN_TOP = none known)
+    std::vector<int32_t> column_top;
+
+    // One tile in the flood-fill queues (chunk + column-major index into its planes)
+    struct LightNode {
+        Chunk2D* chunk;
+        uint16_t index;         // local_x * CHUNK_HEIGHT + local_y
+        uint32_t level;         // Light being removed (removal queue only, PackedLight in colored mode)
+    };
+
+    // light_opacity / light_emission per block type
+    std::vector<uint8_t> opacity_table;
+    std::vector<uint8_t> emission_table;
+    uint8_t liquid_emission[LIQUID_TYPE_COUNT];
+    uint32_t registry_version;
+
+    // Colored mode: emission tinted by light_color, as PackedLight
+    bool colored_light;
+    std::vector<uint32_t> emission_color_table;
+    uint32_t liquid_emission_color[LIQUID_TYPE_COUNT];
+
+    // Flood-fill queues (keep their capacity between updates)
+    std::vector<LightNode> removal_queue;
+    std::vector<LightNode> spread_queue;
+
+    // Reused by update(): this update's batch, grouped by chunk column
+    std::vector<Vector2i> dirty_chunks;
+    std::vector<std::pair<size_t, size_t>> column_groups;
+    std::vector<size_t> group_cells;
+    size_t rebuild_budget;
+    int focus_tile_x;
+
+    // Parallel rebuild scratch
+    struct BatchChunk {
+        Chunk2D* chunk;
+        int neighbor_batch[4];      // Batch index of the neighbor per side (-1 = not in the batch)
+        Chunk2D* neighbor_clean[4]; // Lit neighbor outside the batch (its light flows in)
+    };
+    std::vector<BatchChunk> batch;
+    std::unordered_map<Vector2i, int, Vector2iHash> batch_index;
+    std::vector<uint32_t> edge_light;          // Light leaving each batch chunk, 4 sides x 32 tiles
+    std::vector<uint8_t> batch_changed;
+    std::vector<std::vector<LightNode>> worker_queues;
+    std::vector<size_t> worker_nodes;
+
+    LightingStats stats;
+
+public:
+    LightingSystem(ChunkManager* chunks, BlockRegistry* registry, ThreadPool* pool = nullptr);
+
+    // Rebuild chunks with dirty_lighting set (new or regenerated chunks), up to the rebuild budget
+    void update();
+
+    // Tile the rebuild order starts from (camera position)
+    void set_focus(Vector2i tile_pos) { focus_tile_x = WorldCoords::wrap_x(tile_pos.x); }
+    void set_rebuild_budget(size_t chunks) { rebuild_budget = chunks; }
+
+    // Relight the columns touched by this frame's block changes
+    void apply_block_events(const BlockChangeEvent* events, size_t count);
+
+    // Relight a single foreground tile change (sky column + block light)
+    void on_block_changed(Vector2i tile_pos);
+
+    // Update block light around tiles whose glowing liquid appeared or drained
+    void apply_liquid_changes(const LiquidCellChange* changes, size_t count);
+
+    // Recompute block light through a tile (its emission or opacity changed)
+    void on_light_source_changed(Vector2i tile_pos);
+
+    // Light emitted by liquid cells of a type (lava glows by default)
+    void set_liquid_emission(LiquidType type, uint8_t emission, const Color& color = Color(1, 1, 1));
+
+    // Switch between monochrome and packed RGB block light (relights every chunk)
+    void set_colored_light(bool enabled);
+    bool is_colored_light() const { return colored_light; }
+
+    // Mark every loaded chunk for a full rebuild (after world generation)
+    void invalidate_all();
+
+    // Highest opaque tile Y in a column (NO_COLUMN_TOP if the column is open)
+    int get_column_top(int tile_x) const { return column_top[WorldCoords::wrap_x(tile_x)]; }
+
+    uint8_t get_sky_light(Vector2i tile_pos) const;
+    uint8_t get_block_light(Vector2i tile_pos) const;
+    uint8_t get_light(Vector2i tile_pos) const;
+
+    // Final RGB light of a tile region as an RGB8 texture (row-major, 3 bytes per
+    // tile, matches Image::FORMAT_RGB8); out is only resized when the region size changes
+    void build_light_texture(const Rect2i& tile_region, PackedByteArray& out) const;
+
+    const LightingStats& get_stats() const { return stats; }
+
+    void clear();
+
+private:
+    // Reload light_opacity / light_emission per type when the registry changes
+    void refresh_block_tables();
+
+    inline uint8_t opacity_of(uint16_t type_id) const {
+        return type_id < opacity_table.size() ? opacity_table[type_id] : 0;
+    }
+
+    // Rows below the sky edge (0 = first lit row, WORLD_HEIGHT = NO_COLUMN_TOP); its own inverse
+    static inline int depth_of(int tile_y) {
+        return DOWN_Y > 0 ? tile_y : WORLD_HEIGHT - 1 - tile_y;
+    }
+
+    // Update column_top for a column after its tiles from from_y down to to_y changed
+    void refresh_column_top(int tile_x, int from_y, int to_y);
+
+    // Highest opaque tile at or below from_y in loaded chunks (NO_COLUMN_TOP if none)
+    int find_column_top(int tile_x, int from_y) const;
+
+    // Skylight entering tile (x, y) from the tile above it
+    uint8_t incoming_sky(int tile_x, int tile_y) const;
+
+    // Recompute skylight from start_y down; every tile up to force_until_y is
+    // rewritten, after that the walk stops at the first unchanged tile; returns cells written
+    size_t relight_column(int tile_x, int start_y, int force_until_y);
+
+    // Light a tile emits (block emission or glowing liquid)
+    uint8_t emission_at(const Chunk2D* chunk, int local_x, int local_y) const;
+    uint32_t color_emission_at(const Chunk2D* chunk, int local_x, int local_y) const;
+
+    template <typename Channel>
+    uint32_t source_at(const Chunk2D* chunk, int local_x, int local_y) const;
+
+    // False if no tile of the chunk can emit (no liquid, no emitting type in its histogram)
+    template <typename Channel>
+    bool has_sources(const Chunk2D* chunk) const;
+
+    // Neighbor of a node in direction 0-3 (left, right, up, down); false if unloaded
+    bool neighbor_node(const LightNode& node, int direction, LightNode& out) const;
+
+    // Store block light and refresh the tile's final light
+    template <typename Channel>
+    static void write_block_light(Chunk2D* chunk, int index, uint32_t value);
+
+    // Two-queue passes (Channel = monochrome or packed RGB planes)
+    template <typename Channel>
+    void relight_source(Chunk2D* chunk, Vector2i local_pos);
+    template <typename Channel>
+    void run_light_removal();
+    template <typename Channel>
+    void run_light_spread();
+
+    // Rebuild block light of dirty chunks (sources inside them + light bordering them)
+    template <typename Channel>
+    void rebuild_block_light();
+    template <typename Channel>
+    void rebuild_block_light_parallel();
+
+    // Flood fill confined to the queued nodes' chunk (safe on worker threads); returns nodes processed
+    template <typename Channel>
+    size_t spread_in_chunk(std::vector<LightNode>& queue) const;
+
+    // Light a tile passes on to its neighbors
+    template <typename Channel>
+    uint32_t outgoing_light(const Chunk2D* chunk, int index) const;
+
+    // Cut dirty_chunks down to this update's batch (whole chunk columns nearest the focus)
+    void select_rebuild_batch();
+
+    // Skylight of every chunk column in the batch
+    void relight_sky_groups();
+};
+
+#endif // LIGHTING_2D_H
@@ -0,0 +1,229 @@
+#include "smooth_lighting.h"
+#include <algorithm>
+#include <chrono>
+
+using namespace godot;
+
+SmoothLighting::SmoothLighting(ChunkManager* chunks)
+    : chunk_manager(chunks)
+    , view(0, 0, 0, 0)
+    , corner_width(0)
+    , corner_height(0)
+    , field_width(0)
+    , field_height(0)
+    , corner_revision(0)
+{}
+
+void SmoothLighting::set_view(const Rect2i& tile_rect) {
+    if (tile_rect.position == view.position && tile_rect.size == view.size && view.has_area()) {
+        return;
+    }
+    bool resized = tile_rect.size != view.size;
+    view = tile_rect;
+    if (!view.has_area()) {
+        clear();
+        return;
+    }
+
+    if (resized) {
+        corner_width = view.size.x + 1;
+        corner_height = view.size.y + 1;
+        field_width = corner_width + 3;
+        field_height = corner_height + 3;
+        field.assign(static_cast<size_t>(field_width) * field_height, 0);
+        row_sums.assign(static_cast<size_t>(corner_width) * 4, 0);
+        corners.assign(static_cast<size_t>(corner_width) * corner_height, 0);
+    }
+
+    // The field moved over the world - reload every chunk under it
+    seen_versions.clear();
+}
+
+void SmoothLighting::mark_dirty(const Rect2i& tile_rect) {
+    if (!view.has_area()) {
+        return;
+    }
+
+    // Reload the chunks under the rectangle
+    int chunk_x0 = WorldGrid::chunk_x(tile_rect.position.x);
+    int chunk_x1 = WorldGrid::chunk_x(tile_rect.position.x + tile_rect.size.x - 1);
+    int chunk_y0 = WorldGrid::chunk_y(tile_rect.position.y);
+    int chunk_y1 = WorldGrid::chunk_y(tile_rect.position.y + tile_rect.size.y - 1);
+    for (int cy = chunk_y0; cy <= chunk_y1; cy++) {
+        for (int cx = chunk_x0; cx <= chunk_x1; cx++) {
+            seen_versions.erase(Vector2i(cx, cy));
+        }
+    }
+}
+
+void SmoothLighting::update() {
+    if (!view.has_area()) {
+        return;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    stats.rects_updated = 0;
+    stats.corners_updated = 0;
+
+    // Field tiles in world coords (unwrapped X)
+    const Vector2i field_origin = view.position - Vector2i(KERNEL_REACH, KERNEL_REACH);
+    const Vector2i field_end = field_origin + Vector2i(field_width, field_height);
+
+    int chunk_x0 = WorldGrid::chunk_x(field_origin.x);
+    int chunk_x1 = WorldGrid::chunk_x(field_end.x - 1);
+    int chunk_y0 = WorldGrid::chunk_y(field_origin.y);
+    int chunk_y1 = WorldGrid::chunk_y(field_end.y - 1);
+
+    // The last changes stay readable until something else changes
+    bool changed = false;
+    for (int cy = chunk_y0; cy <= chunk_y1; cy++) {
+        for (int cx = chunk_x0; cx <= chunk_x1; cx++) {
+            // Missing chunks count as version 0 and are reloaded once they arrive
+            const Chunk2D* chunk = static_cast<const ChunkManager*>(chunk_manager)->get_chunk(Vector2i(cx, cy));
+            uint32_t version = chunk ? chunk->get_layer_version(CHUNK_LAYER_LIGHT) + 1 : 0;
+
+            // Only the tiles relit since the last load (the whole chunk when first seen)
+            Rect2i relit(0, 0, CHUNK_WIDTH, CHUNK_HEIGHT);
+            auto it = seen_versions.find(Vector2i(cx, cy));
+            if (it != seen_versions.end()) {
+                if (it->second == version) {
+                    continue;
+                }
+                if (chunk && it->second != 0) {
+                    chunk->get_changes_since(CHUNK_LAYER_LIGHT, it->second - 1, relit);
+                }
+            }
+            seen_versions[Vector2i(cx, cy)] = version;
+
+            // Relit tiles clipped to the field
+            const Vector2i chunk_origin(WorldGrid::origin_x(cx), WorldGrid::origin_y(cy));
+            Vector2i from = chunk_origin + relit.position;
+            Vector2i to = from + relit.size;
+            from = Vector2i(std::max(from.x, field_origin.x), std::max(from.y, field_origin.y));
+            to = Vector2i(std::min(to.x, field_end.x), std::min(to.y, field_end.y));
+            if (to.x <= from.x || to.y <= from.y) {
+                continue;
+            }
+
+            if (!changed) {
+                dirty_rects.clear();
+                corner_revision++;
+                changed = true;
+            }
+            Rect2i tile_rect(from, to - from);
+            load_tiles(tile_rect);
+            queue_corners(tile_rect);
+        }
+    }
+
+    // Blur after every changed tile is loaded (a rect's kernel reaches into its neighbors)
+    for (size_t i = 0; changed && i < dirty_rects.size(); i++) {
+        const Rect2i& rect = dirty_rects[i];
+        const int offset_field = rect.position.y * field_width + rect.position.x;
+        const int offset_corner = rect.position.y * corner_width + rect.position.x;
+        blur_corners(field.data() + offset_field, field_width, row_sums.data(),
+                     corners.data() + offset_corner, corner_width, rect.size.x, rect.size.y);
+        stats.rects_updated++;
+        stats.corners_updated += static_cast<size_t>(rect.size.x) * rect.size.y;
+    }
+
+    stats.update_usec = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count());
+}
+
+uint8_t SmoothLighting::get_corner(Vector2i corner_pos) const {
+    Vector2i local = corner_pos - view.position;
+    if (local.x < 0 || local.y < 0 || local.x >= corner_width || local.y >= corner_height) {
+        return 0;
+    }
+    return corners[local.y * corner_width + local.x];
+}
+
+void SmoothLighting::clear() {
+    view = Rect2i(0, 0, 0, 0);
+    corner_width = 0;
+    corner_height = 0;
+    field_width = 0;
+    field_height = 0;
+    field.clear();
+    row_sums.clear();
+    corners.clear();
+    seen_versions.clear();
+    dirty_rects.clear();
+    stats = SmoothLightingStats();
+}
+
+void SmoothLighting::load_tiles(const Rect2i& tile_rect) {
+    const Vector2i field_origin = view.position - Vector2i(KERNEL_REACH, KERNEL_REACH);
+
+    // The rect lies inside one chunk: walk its columns (the light plane is column-major)
+    const Vector2i chunk_pos = WorldCoords::tile_to_chunk(tile_rect.position);
+    const Chunk2D* chunk = static_cast<const ChunkManager*>(chunk_manager)->get_chunk(chunk_pos);
+    const int local_x0 = WorldGrid::local_x(tile_rect.position.x);
+    const int local_y0 = WorldGrid::local_y(tile_rect.position.y);
+
+    for (int i = 0; i < tile_rect.size.x; i++) {
+        uint8_t* dst = field.data() + (tile_rect.position.y - field_origin.y) * field_width +
+                       (tile_rect.position.x - field_origin.x + i);
+        for (int j = 0; j < tile_rect.size.y; j++, dst += field_width) {
+            *dst = chunk ? chunk->lighting[local_x0 + i][local_y0 + j] : MIN_LIGHT_LEVEL;
+        }
+    }
+}
+
+void SmoothLighting::queue_corners(const Rect2i& tile_rect) {
+    // Corner c reads tiles c - 2 .. c + 1, so tiles a..b reach corners a - 1 .. b + 2
+    Vector2i from = tile_rect.position - view.position - Vector2i(1, 1);
+    Vector2i to = tile_rect.position + tile_rect.size - view.position + Vector2i(2, 2);
+    from = Vector2i(std::max(from.x, 0), std::max(from.y, 0));
+    to = Vector2i(std::min(to.x, corner_width), std::min(to.y, corner_height));
+    if (to.x > from.x && to.y > from.y) {
+        dirty_rects.push_back(Rect2i(from, to - from));
+    }
+}
+
+void SmoothLighting::blur_corners(const uint8_t* tiles, int tile_stride, uint16_t* scratch,
+                                  uint8_t* out, int out_stride, int width, int height) {
+    // Horizontal sums of the last four tile rows, reused as the window slides down
+    uint16_t* sums[4] = { scratch, scratch + width, scratch + 2 * width, scratch + 3 * width };
+
+    for (int row = 0; row < height + 3; row++) {
+        // Horizontal [1 2 2 1] of the next tile row
+        const uint8_t* t = tiles + row * tile_stride;
+        uint16_t* h = sums[row & 3];
+        for (int c = 0; c < width; c++) {
+            h[c] = static_cast<uint16_t>(t[c] + 2 * (t[c + 1] + t[c + 2]) + t[c + 3]);
+        }
+        if (row < 3) {
+            continue;
+        }
+
+        // Vertical [1 2 2 1], then round(sum / 36): (sum + 18) * 3641 >> 17 is exact for sum <= 9180
+        const uint16_t* h0 = sums[(row - 3) & 3];
+        const uint16_t* h1 = sums[(row - 2) & 3];
+        const uint16_t* h2 = sums[(row - 1) & 3];
+        const uint16_t* h3 = h;
+        uint8_t* o = out + (row - 3) * out_stride;
+        for (int c = 0; c < width; c++) {
+            uint32_t sum = h0[c] + 2u * (h1[c] + h2[c]) + h3[c];
+            o[c] = static_cast<uint8_t>(((sum + 18) * 3641u) >> 17);
+        }
+    }
+}
+
+void SmoothLighting::blur_corners_reference(const uint8_t* tiles, int tile_stride,
+                                            uint8_t* out, int out_stride, int width, int height) {
+    static const int weights[4] = { 1, 2, 2, 1 };
+
+    for (int row = 0; row < height; row++) {
+        for (int c = 0; c < width; c++) {
+            int sum = 0;
+            for (int dy = 0; dy < 4; dy++) {
+                for (int dx = 0; dx < 4; dx++) {
+                    sum += weights[dy] * weights[dx] * tiles[(row + dy) * tile_stride + c + dx];
+                }
+            }
+            out[row * out_stride + c] = static_cast<uint8_t>((sum + 18) / 36);
+        }
+    }
+}
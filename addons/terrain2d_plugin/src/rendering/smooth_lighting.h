@@ -0,0 +1,113 @@
+#ifndef SMOOTH_LIGHTING_H
+#define SMOOTH_LIGHTING_H
+
+#include "../world/world_constants.h"
+#include "../world/chunk_2d.h"
+#include "../core/chunk_manager.h"
+#include <godot_cpp/variant/vector2i.hpp>
+#include <godot_cpp/variant/rect2i.hpp>
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
+
+using namespace godot;
+
+// Counters from the last smooth lighting update (for debug overlays and profiling)
+struct SmoothLightingStats {
+    size_t rects_updated;       // Dirty corner rectangles re-blurred
+    size_t corners_updated;
+    uint64_t update_usec;
+
+    SmoothLightingStats()
+        : rects_updated(0)
+        , corners_updated(0)
+        , update_usec(0)
+    {}
+};
+
+// Per-corner smooth light of the visible area
+// The guide's 3x3 box blur, sampled at tile corners (where the mesher puts
+// vertex light), is one separable [1 2 2 1] / 6 filter per axis over the 4x4
+// tiles around each corner. Each tile row is summed horizontally once into a
+// four-row window, and each corner row is the vertical sum of that window
+// with an exact divide by 36 - branch-free loops over contiguous rows the
+// compiler vectorizes. The view's tile light is kept row-major with a kernel
+// margin; only the tiles of each chunk's light layer edited since the last
+// update are reloaded, and only the corners they reach are blurred again.
+class SmoothLighting {
+public:
+    // Tiles a corner reads on its low side (the high side reads one)
+    static constexpr int KERNEL_REACH = 2;
+
+private:
+    ChunkManager* chunk_manager;
+
+    // Tiles covered; corner (0, 0) is the top-left corner of view.position
+    Rect2i view;
+    int corner_width;       // view.size.x + 1
+    int corner_height;      // view.size.y + 1
+
+    // Tile light of the view plus the kernel margin (row-major, field column c feeds corner c)
+    std::vector<uint8_t> field;
+    int field_width;        // corner_width + 3
+    int field_height;       // corner_height + 3
+
+    std::vector<uint16_t> row_sums;     // Horizontal sums of the last 4 tile rows
+    std::vector<uint8_t> corners;       // Result (row-major, stride corner_width)
+
+    // Light layer version + 1 last loaded per chunk overlapping the field
+    // (unwrapped chunk coords, 0 = chunk was missing)
+    std::unordered_map<Vector2i, uint32_t, Vector2iHash> seen_versions;
+    std::vector<Rect2i> dirty_rects;    // Corner space, refreshed by update()
+    uint32_t corner_revision;           // Bumped by every update that re-blurred corners
+
+    SmoothLightingStats stats;
+
+public:
+    SmoothLighting(ChunkManager* chunks);
+
+    // Tile rectangle to keep smooth light for (resizing reloads everything)
+    void set_view(const Rect2i& tile_rect);
+    const Rect2i& get_view() const { return view; }
+
+    // Force tiles to be reloaded and re-blurred on the next update
+    void mark_dirty(const Rect2i& tile_rect);
+
+    // Reload changed chunks and re-blur the corners they reach
+    void update();
+
+    // Light at the top-left corner of a tile (0 outside the view)
+    uint8_t get_corner(Vector2i corner_pos) const;
+
+    // Corner grid of the view (corner_width x corner_height, row-major)
+    const uint8_t* get_corners() const { return corners.data(); }
+    int get_corner_width() const { return corner_width; }
+    int get_corner_height() const { return corner_height; }
+
+    // Corner rectangles (relative to the view) re-blurred by the last update
+    // that changed anything, and the revision that update bumped to
+    const std::vector<Rect2i>& get_dirty_rects() const { return dirty_rects; }
+    uint32_t get_corner_revision() const { return corner_revision; }
+
+    const SmoothLightingStats& get_stats() const { return stats; }
+
+    void clear();
+
+    // Blur width x height corners; tiles must hold (width + 3) x (height + 3)
+    // values, scratch 4 * width
+    static void blur_corners(const uint8_t* tiles, int tile_stride, uint16_t* scratch,
+                             uint8_t* out, int out_stride, int width, int height);
+
+    // Direct 16-tap version of the same filter (reference for blur_corners)
+    static void blur_corners_reference(const uint8_t* tiles, int tile_stride,
+                                       uint8_t* out, int out_stride, int width, int height);
+
+private:
+    // Copy final light of a tile rectangle (world coords, inside the field) into the field
+    void load_tiles(const Rect2i& tile_rect);
+
+    // Queue the corners that read a tile rectangle (world coords)
+    void queue_corners(const Rect2i& tile_rect);
+};
+
+#endif // SMOOTH_LIGHTING_H
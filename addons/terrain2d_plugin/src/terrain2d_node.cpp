@@ -0,0 +1,537 @@
+#include "terrain2d_node.h"
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/classes/physics_server2d.hpp>
+#include <godot_cpp/classes/world2d.hpp>
+#include <godot_cpp/variant/transform2d.hpp>
+#include <godot_cpp/variant/array.hpp>
+#include <algorithm>
+
+using namespace godot;
+
+// Rays per thread pool task in raycast_tiles_batch (smaller batches run inline)
+static constexpr size_t RAYCAST_GROUP_SIZE = 64;
+
+Terrain2D::Terrain2D() {
+    block_registry = BlockRegistry::get_singleton();
+    owns_block_registry = (block_registry == nullptr);
+    if (owns_block_registry) {
+        block_registry = new BlockRegistry();
+        block_registry->initialize_default_blocks();
+    }
+
+    chunk_manager = new ChunkManager();
+    chunk_manager->set_block_registry(block_registry);
+    biome_system = new BiomeSystem();
+    world_generator = new WorldGenerator(chunk_manager, block_registry, biome_system);
+    item_drops = new ItemDropSystem(chunk_manager);
+    tension_system = new BlockTensionSystem(chunk_manager, block_registry, item_drops);
+    damage_system = new BlockDamageSystem(chunk_manager, block_registry, tension_system, item_drops);
+    liquid_reactions = new LiquidReactionSystem(chunk_manager, block_registry, biome_system, damage_system);
+    liquid_reactions->initialize_default_reactions();
+    liquid_system = new LiquidSystem(chunk_manager, liquid_reactions);
+    thread_pool = new ThreadPool();
+    lighting_system = new LightingSystem(chunk_manager, block_registry, thread_pool);
+    smooth_lighting = new SmoothLighting(chunk_manager);
+    auto_tiling = new AutoTileSystem(chunk_manager, block_registry);
+    chunk_mesher = new ChunkMesher(chunk_manager, block_registry, smooth_lighting, auto_tiling, thread_pool);
+    collision_system = new TerrainCollisionSystem(chunk_manager);
+}
+
+Terrain2D::~Terrain2D() {
+    for (auto& pair : collision_bodies) {
+        free_chunk_body(pair.second);
+    }
+    collision_bodies.clear();
+    delete collision_system;
+    chunk_meshes.clear();
+    delete chunk_mesher;
+    delete auto_tiling;
+    delete smooth_lighting;
+    delete lighting_system;
+    delete thread_pool;
+    delete liquid_system;
+    delete liquid_reactions;
+    delete damage_system;
+    delete tension_system;
+    delete item_drops;
+    delete world_generator;
+    delete biome_system;
+    delete chunk_manager;
+    if (owns_block_registry) {
+        delete block_registry;
+    }
+}
+
+void Terrain2D::_bind_methods() {
+    ClassDB::bind_method(D_METHOD("set_block", "pos", "block_id", "background"), &Terrain2D::set_block, DEFVAL(false));
+    ClassDB::bind_method(D_METHOD("get_block", "pos", "background"), &Terrain2D::get_block, DEFVAL(false));
+    ClassDB::bind_method(D_METHOD("place_block", "pos", "block_id", "background"), &Terrain2D::place_block, DEFVAL(false));
+    ClassDB::bind_method(D_METHOD("get_block_origin", "pos", "background"), &Terrain2D::get_block_origin, DEFVAL(false));
+    ClassDB::bind_method(D_METHOD("get_chunk_anchors", "chunk_pos"), &Terrain2D::get_chunk_anchors);
+    ClassDB::bind_method(D_METHOD("damage_block_3x3", "center", "damage", "tool_tier"), &Terrain2D::damage_block_3x3, DEFVAL(0));
+    ClassDB::bind_method(D_METHOD("get_item_drop_transforms"), &Terrain2D::get_item_drop_transforms);
+    ClassDB::bind_method(D_METHOD("get_item_drop_count"), &Terrain2D::get_item_drop_count);
+    ClassDB::bind_method(D_METHOD("collect_item_drops", "world_pos", "radius"), &Terrain2D::collect_item_drops);
+    ClassDB::bind_method(D_METHOD("add_liquid", "pos", "type", "amount"), &Terrain2D::add_liquid);
+    ClassDB::bind_method(D_METHOD("get_liquid_level", "pos"), &Terrain2D::get_liquid_level);
+    ClassDB::bind_method(D_METHOD("get_active_liquid_count"), &Terrain2D::get_active_liquid_count);
+    ClassDB::bind_method(D_METHOD("get_light_level", "pos"), &Terrain2D::get_light_level);
+    ClassDB::bind_method(D_METHOD("get_surface_height", "tile_x"), &Terrain2D::get_surface_height);
+    ClassDB::bind_method(D_METHOD("set_colored_lighting", "enabled"), &Terrain2D::set_colored_lighting);
+    ClassDB::bind_method(D_METHOD("is_colored_lighting"), &Terrain2D::is_colored_lighting);
+    ClassDB::bind_method(D_METHOD("get_light_texture", "tile_region"), &Terrain2D::get_light_texture);
+    ClassDB::bind_method(D_METHOD("set_light_view", "tile_rect"), &Terrain2D::set_light_view);
+    ClassDB::bind_method(D_METHOD("get_corner_light", "corner_pos"), &Terrain2D::get_corner_light);
+    ClassDB::bind_method(D_METHOD("get_chunk_mesh", "chunk_pos"), &Terrain2D::get_chunk_mesh);
+    ClassDB::bind_method(D_METHOD("set_tile_atlas_grid", "columns", "rows"), &Terrain2D::set_tile_atlas_grid);
+    ClassDB::bind_method(D_METHOD("set_collision_radius", "chunk_radius"), &Terrain2D::set_collision_radius);
+    ClassDB::bind_method(D_METHOD("get_collision_shape_count"), &Terrain2D::get_collision_shape_count);
+    ClassDB::bind_method(D_METHOD("get_collision_update_usec"), &Terrain2D::get_collision_update_usec);
+    ClassDB::bind_method(D_METHOD("move_and_collide_tiles", "aabb", "motion", "collide_platforms"), &Terrain2D::move_and_collide_tiles, DEFVAL(true));
+    ClassDB::bind_method(D_METHOD("move_and_slide_tiles", "aabb", "motion", "collide_platforms"), &Terrain2D::move_and_slide_tiles, DEFVAL(true));
+    ClassDB::bind_method(D_METHOD("raycast_tiles", "from", "to", "hit_platforms"), &Terrain2D::raycast_tiles, DEFVAL(false));
+    ClassDB::bind_method(D_METHOD("raycast_tiles_batch", "from", "to", "hit_platforms"), &Terrain2D::raycast_tiles_batch, DEFVAL(false));
+    ClassDB::bind_method(D_METHOD("count_blocks_in_chunks", "block_id", "chunk_region", "background"), &Terrain2D::count_blocks_in_chunks, DEFVAL(false));
+    ClassDB::bind_method(D_METHOD("get_chunk_edit_version", "chunk_pos"), &Terrain2D::get_chunk_edit_version);
+    ClassDB::bind_method(D_METHOD("get_chunk_changes_since", "chunk_pos", "version", "layer"), &Terrain2D::get_chunk_changes_since);
+    ClassDB::bind_method(D_METHOD("generate_world", "seed"), &Terrain2D::generate_world);
+    ClassDB::bind_method(D_METHOD("update_active_chunks", "camera_world_pos"), &Terrain2D::update_active_chunks);
+
+    ADD_SIGNAL(MethodInfo("blocks_changed", PropertyInfo(Variant::PACKED_INT32_ARRAY, "events")));
+    ADD_SIGNAL(MethodInfo("chunk_meshes_changed", PropertyInfo(Variant::PACKED_INT32_ARRAY, "updated"),
+                          PropertyInfo(Variant::PACKED_INT32_ARRAY, "released")));
+}
+
+void Terrain2D::_process(double delta) {
+    float dt = static_cast<float>(delta);
+
+    // Block definitions may have changed since the last frame
+    chunk_manager->refresh_collision_rows();
+
+    // Chunks loaded or regenerated since last frame
+    lighting_system->update();
+
+    tension_system->process_stability_queue();
+    tension_system->update(dt);
+    damage_system->update_regeneration(dt);
+    item_drops->update(dt);
+    liquid_system->update(dt);
+
+    publish_block_changes();
+
+    // After every light change of the frame
+    smooth_lighting->update();
+
+    // Meshes read the final blocks and corner light of the frame
+    chunk_mesher->update();
+    publish_chunk_meshes();
+
+    collision_system->update();
+    publish_collision_shapes();
+}
+
+void Terrain2D::publish_block_changes() {
+    BlockEventStream& events = chunk_manager->get_block_events();
+    events.publish_frame();
+
+    // Liquid next to changed blocks may be able to flow again
+    liquid_system->wake_from_events(events.get_frame_events(), events.get_frame_event_count());
+
+    // Relight only the column spans below changed blocks
+    lighting_system->apply_block_events(events.get_frame_events(), events.get_frame_event_count());
+
+    // Lava that flowed in or drained this frame moves its glow
+    const std::vector<LiquidCellChange>& liquid_changes = liquid_system->get_cell_changes();
+    lighting_system->apply_liquid_changes(liquid_changes.data(), liquid_changes.size());
+    liquid_system->clear_cell_changes();
+
+    // Tile shapes around changed blocks, collision of the chunks holding them
+    auto_tiling->apply_block_events(events.get_frame_events(), events.get_frame_event_count());
+    collision_system->apply_block_events(events.get_frame_events(), events.get_frame_event_count());
+
+    if (events.get_frame_event_count() == 0) {
+        return;
+    }
+
+    // One signal per frame, never per tile
+    events.pack_frame(packed_events);
+    emit_signal("blocks_changed", packed_events);
+}
+
+void Terrain2D::publish_chunk_meshes() {
+    const std::vector<Vector2i>& updated = chunk_mesher->get_updated_chunks();
+    const std::vector<Vector2i>& released = chunk_mesher->get_released_chunks();
+    if (updated.empty() && released.empty()) {
+        return;
+    }
+
+    released_mesh_chunks.resize(static_cast<int64_t>(released.size() * 2));
+    int32_t* released_out = released_mesh_chunks.ptrw();
+    for (size_t i = 0; i < released.size(); i++) {
+        chunk_meshes.erase(released[i]);
+        released_out[i * 2] = released[i].x;
+        released_out[i * 2 + 1] = released[i].y;
+    }
+
+    updated_mesh_chunks.resize(static_cast<int64_t>(updated.size() * 2));
+    int32_t* updated_out = updated_mesh_chunks.ptrw();
+    for (size_t i = 0; i < updated.size(); i++) {
+        const ChunkMeshData* data = chunk_mesher->get_mesh(updated[i]);
+        updated_out[i * 2] = updated[i].x;
+        updated_out[i * 2 + 1] = updated[i].y;
+
+        Ref<ArrayMesh>& mesh = chunk_meshes[updated[i]];
+        if (mesh.is_null()) {
+            mesh.instantiate();
+        }
+        mesh->clear_surfaces();
+        if (!data || data->vertices.empty()) {
+            continue;
+        }
+
+        // The mesher's buffers already have the packed layout
+        mesh_vertices.resize(static_cast<int64_t>(data->vertices.size()));
+        mesh_uvs.resize(static_cast<int64_t>(data->uvs.size()));
+        mesh_colors.resize(static_cast<int64_t>(data->colors.size()));
+        mesh_indices.resize(static_cast<int64_t>(data->indices.size()));
+        std::copy(data->vertices.begin(), data->vertices.end(), mesh_vertices.ptrw());
+        std::copy(data->uvs.begin(), data->uvs.end(), mesh_uvs.ptrw());
+        std::copy(data->colors.begin(), data->colors.end(), mesh_colors.ptrw());
+        std::copy(data->indices.begin(), data->indices.end(), mesh_indices.ptrw());
+
+        Array arrays;
+        arrays.resize(Mesh::ARRAY_MAX);
+        arrays[Mesh::ARRAY_VERTEX] = mesh_vertices;
+        arrays[Mesh::ARRAY_TEX_UV] = mesh_uvs;
+        arrays[Mesh::ARRAY_COLOR] = mesh_colors;
+        arrays[Mesh::ARRAY_INDEX] = mesh_indices;
+        mesh->add_surface_from_arrays(Mesh::PRIMITIVE_TRIANGLES, arrays);
+    }
+
+    chunk_mesher->clear_results();
+    emit_signal("chunk_meshes_changed", updated_mesh_chunks, released_mesh_chunks);
+}
+
+void Terrain2D::publish_collision_shapes() {
+    const std::vector<Vector2i>& updated = collision_system->get_updated_chunks();
+    const std::vector<Vector2i>& released = collision_system->get_released_chunks();
+    if (updated.empty() && released.empty()) {
+        return;
+    }
+    // Bodies need the world's physics space - keep the results until the node is in the tree
+    if (!is_inside_tree()) {
+        return;
+    }
+
+    PhysicsServer2D* physics = PhysicsServer2D::get_singleton();
+    for (const Vector2i& chunk_pos : released) {
+        auto it = collision_bodies.find(chunk_pos);
+        if (it != collision_bodies.end()) {
+            free_chunk_body(it->second);
+            collision_bodies.erase(it);
+        }
+    }
+
+    const float tile = static_cast<float>(TILE_SIZE_PIXELS);
+    const RID space = get_world_2d()->get_space();
+    for (const Vector2i& chunk_pos : updated) {
+        const std::vector<CollisionRect>* rects = collision_system->get_rects(chunk_pos);
+        if (!rects) {
+            continue;
+        }
+
+        ChunkBody& body = collision_bodies[chunk_pos];
+        if (!body.body.is_valid()) {
+            body.body = physics->body_create();
+            physics->body_set_mode(body.body, PhysicsServer2D::BODY_MODE_STATIC);
+            physics->body_set_space(body.body, space);
+            Vector2 origin(chunk_pos.x * CHUNK_WIDTH * tile, chunk_pos.y * CHUNK_HEIGHT * tile);
+            physics->body_set_state(body.body, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0.0f, origin));
+        }
+
+        // Shapes are reused, only their extents and offsets change
+        physics->body_clear_shapes(body.body);
+        while (body.shapes.size() < rects->size()) {
+            body.shapes.push_back(physics->rectangle_shape_create());
+        }
+        while (body.shapes.size() > rects->size()) {
+            physics->free_rid(body.shapes.back());
+            body.shapes.pop_back();
+        }
+        for (size_t i = 0; i < rects->size(); i++) {
+            const CollisionRect& rect = (*rects)[i];
+            Vector2 half_extents(rect.width * tile * 0.5f, rect.height * tile * 0.5f);
+            Vector2 center = Vector2(rect.x * tile, rect.y * tile) + half_extents;
+            physics->shape_set_data(body.shapes[i], half_extents);
+            physics->body_add_shape(body.body, body.shapes[i], Transform2D(0.0f, center));
+            if (rect.one_way) {
+                physics->body_set_shape_as_one_way_collision(body.body, static_cast<int>(i), true, 1.0f);
+            }
+        }
+    }
+
+    collision_system->clear_results();
+}
+
+void Terrain2D::free_chunk_body(ChunkBody& body) {
+    PhysicsServer2D* physics = PhysicsServer2D::get_singleton();
+    if (!physics) {
+        return;
+    }
+    if (body.body.is_valid()) {
+        physics->free_rid(body.body);
+    }
+    for (const RID& shape : body.shapes) {
+        physics->free_rid(shape);
+    }
+    body.body = RID();
+    body.shapes.clear();
+}
+
+void Terrain2D::set_block(Vector2i pos, int block_id, bool background) {
+    Block2D block;
+    block.type_id = static_cast<uint16_t>(block_id);
+    chunk_manager->set_block_at_tile(pos, block, background, CAUSE_PLACED);
+}
+
+int Terrain2D::get_block(Vector2i pos, bool background) const {
+    return chunk_manager->get_block_type_at_tile(pos, background);
+}
+
+bool Terrain2D::place_block(Vector2i pos, int block_id, bool background) {
+    if (block_id <= 0 || block_id > 0xFFFF) {
+        return false;
+    }
+    Block2D block;
+    block.type_id = static_cast<uint16_t>(block_id);
+    return chunk_manager->place_multi_tile(pos, block, background, CAUSE_PLACED);
+}
+
+Vector2i Terrain2D::get_block_origin(Vector2i pos, bool background) const {
+    Vector2i origin;
+    return chunk_manager->get_multi_tile_origin(pos, background, origin) ? origin : WorldCoords::wrap_tile_x(pos);
+}
+
+PackedInt32Array Terrain2D::get_chunk_anchors(Vector2i chunk_pos) const {
+    PackedInt32Array result;
+    const Chunk2D* chunk = static_cast<const ChunkManager*>(chunk_manager)->get_chunk(chunk_pos);
+    if (!chunk) {
+        return result;
+    }
+    for (const ChunkAnchorIndex::Anchor& anchor : chunk->anchors.get_anchors()) {
+        const Vector2i origin = WorldCoords::chunk_local_to_tile(chunk->chunk_position, Vector2i(anchor.x, anchor.y));
+        result.push_back(origin.x);
+        result.push_back(origin.y);
+        result.push_back(anchor.type_id);
+        result.push_back(anchor.background ? 1 : 0);
+    }
+    return result;
+}
+
+int Terrain2D::damage_block_3x3(Vector2i center, float damage, int tool_tier) {
+    Tool tool(damage, tool_tier, 1.0f);
+    damage_results.clear();
+    damage_system->damage_3x3_area(center, damage, tool, damage_results);
+    return static_cast<int>(damage_results.size());
+}
+
+PackedFloat32Array Terrain2D::get_item_drop_transforms() const {
+    return item_drops->get_transform_buffer();
+}
+
+int Terrain2D::get_item_drop_count() const {
+    return static_cast<int>(item_drops->get_drop_count());
+}
+
+PackedInt32Array Terrain2D::collect_item_drops(Vector2 world_pos, float radius) {
+    PackedInt32Array items;
+    item_drops->collect(world_pos, radius, items);
+    return items;
+}
+
+bool Terrain2D::add_liquid(Vector2i pos, int type, float amount) {
+    if (type <= LIQUID_NONE || type >= LIQUID_TYPE_COUNT) {
+        return false;
+    }
+    return liquid_system->add_liquid(pos, static_cast<LiquidType>(type), amount);
+}
+
+float Terrain2D::get_liquid_level(Vector2i pos) {
+    return liquid_system->get_liquid_level(pos);
+}
+
+int Terrain2D::get_active_liquid_count() const {
+    return static_cast<int>(liquid_system->get_active_row_count());
+}
+
+int Terrain2D::get_light_level(Vector2i pos) const {
+    return lighting_system->get_light(pos);
+}
+
+int Terrain2D::get_surface_height(int tile_x) const {
+    return lighting_system->get_column_top(tile_x);
+}
+
+void Terrain2D::set_colored_lighting(bool enabled) {
+    lighting_system->set_colored_light(enabled);
+}
+
+bool Terrain2D::is_colored_lighting() const {
+    return lighting_system->is_colored_light();
+}
+
+PackedByteArray Terrain2D::get_light_texture(Rect2i tile_region) {
+    lighting_system->build_light_texture(tile_region, light_texture);
+    return light_texture;
+}
+
+void Terrain2D::set_light_view(Rect2i tile_rect) {
+    smooth_lighting->set_view(tile_rect);
+}
+
+int Terrain2D::get_corner_light(Vector2i corner_pos) const {
+    return smooth_lighting->get_corner(corner_pos);
+}
+
+Ref<ArrayMesh> Terrain2D::get_chunk_mesh(Vector2i chunk_pos) const {
+    // Meshes are keyed by the wrapped position the chunk is stored under
+    const Chunk2D* chunk = static_cast<const ChunkManager*>(chunk_manager)->get_chunk(chunk_pos);
+    if (!chunk) {
+        return Ref<ArrayMesh>();
+    }
+    auto it = chunk_meshes.find(chunk->chunk_position);
+    return it != chunk_meshes.end() ? it->second : Ref<ArrayMesh>();
+}
+
+void Terrain2D::set_tile_atlas_grid(int columns, int rows) {
+    chunk_mesher->set_atlas_grid(columns, rows);
+}
+
+void Terrain2D::set_collision_radius(Vector2i chunk_radius) {
+    collision_system->set_radius(chunk_radius);
+}
+
+int Terrain2D::get_collision_shape_count() const {
+    return static_cast<int>(collision_system->get_stats().active_rects);
+}
+
+int Terrain2D::get_collision_update_usec() const {
+    return static_cast<int>(collision_system->get_stats().update_usec);
+}
+
+Dictionary Terrain2D::move_and_collide_tiles(Rect2 aabb, Vector2 motion, bool collide_platforms) const {
+    TileSweepResult sweep = chunk_manager->move_and_collide_tiles(aabb, motion, collide_platforms);
+    Dictionary result;
+    result["hit"] = sweep.hit;
+    result["time"] = sweep.time;
+    result["travel"] = sweep.travel;
+    result["remainder"] = sweep.remainder;
+    result["normal"] = sweep.normal;
+    result["tile"] = sweep.tile;
+    return result;
+}
+
+Dictionary Terrain2D::move_and_slide_tiles(Rect2 aabb, Vector2 motion, bool collide_platforms) const {
+    TileSlideResult slide = chunk_manager->move_and_slide_tiles(aabb, motion, collide_platforms);
+    Dictionary result;
+    result["travel"] = slide.travel;
+    result["remainder"] = slide.remainder;
+    result["on_floor"] = slide.on_floor;
+    result["on_wall"] = slide.on_wall;
+    result["on_ceiling"] = slide.on_ceiling;
+    return result;
+}
+
+Dictionary Terrain2D::raycast_tiles(Vector2 from, Vector2 to, bool hit_platforms) const {
+    TileRayHit ray = chunk_manager->raycast_tiles(from, to, hit_platforms);
+    Dictionary result;
+    result["hit"] = ray.hit;
+    result["tile"] = ray.tile;
+    result["normal"] = ray.normal;
+    result["distance"] = ray.distance;
+    result["position"] = ray.position;
+    return result;
+}
+
+PackedFloat32Array Terrain2D::raycast_tiles_batch(const PackedVector2Array& from, const PackedVector2Array& to,
+                                                  bool hit_platforms) const {
+    const size_t count = static_cast<size_t>(std::min(from.size(), to.size()));
+    PackedFloat32Array result;
+    result.resize(static_cast<int64_t>(count * 5));
+    if (count == 0) {
+        return result;
+    }
+
+    const Vector2* from_ptr = from.ptr();
+    const Vector2* to_ptr = to.ptr();
+    float* out = result.ptrw();
+    auto cast_group = [&](size_t group, int) {
+        const size_t first = group * RAYCAST_GROUP_SIZE;
+        const size_t last = std::min(first + RAYCAST_GROUP_SIZE, count);
+        for (size_t i = first; i < last; i++) {
+            const TileRayHit ray = chunk_manager->raycast_tiles(from_ptr[i], to_ptr[i], hit_platforms);
+            float* ray_out = out + i * 5;
+            ray_out[0] = ray.hit ? ray.distance : -1.0f;
+            ray_out[1] = static_cast<float>(ray.tile.x);
+            ray_out[2] = static_cast<float>(ray.tile.y);
+            ray_out[3] = static_cast<float>(ray.normal.x);
+            ray_out[4] = static_cast<float>(ray.normal.y);
+        }
+    };
+
+    // Reads only, so rays are cast on the pool (nothing edits blocks meanwhile)
+    const size_t groups = (count + RAYCAST_GROUP_SIZE - 1) / RAYCAST_GROUP_SIZE;
+    if (groups > 1) {
+        thread_pool->parallel_for(groups, cast_group);
+    } else {
+        cast_group(0, 0);
+    }
+    return result;
+}
+
+int64_t Terrain2D::count_blocks_in_chunks(int block_id, Rect2i chunk_region, bool background) const {
+    if (block_id <= 0 || block_id > 0xFFFF) {
+        return 0;
+    }
+    return chunk_manager->count_blocks(static_cast<uint16_t>(block_id), chunk_region, background);
+}
+
+int64_t Terrain2D::get_chunk_edit_version(Vector2i chunk_pos) const {
+    const Chunk2D* chunk = static_cast<const ChunkManager*>(chunk_manager)->get_chunk(chunk_pos);
+    return chunk ? static_cast<int64_t>(chunk->edit_version) : -1;
+}
+
+Rect2i Terrain2D::get_chunk_changes_since(Vector2i chunk_pos, int64_t version, int layer) const {
+    const Chunk2D* chunk = static_cast<const ChunkManager*>(chunk_manager)->get_chunk(chunk_pos);
+    if (!chunk || layer < 0 || layer >= CHUNK_LAYER_COUNT) {
+        return Rect2i();
+    }
+    Rect2i region;
+    const uint32_t since = static_cast<uint32_t>(std::max<int64_t>(version, 0));
+    if (!chunk->get_changes_since(static_cast<ChunkLayer>(layer), since, region)) {
+        return Rect2i();
+    }
+    region.position = WorldCoords::chunk_local_to_tile(chunk->chunk_position, region.position);
+    return region;
+}
+
+void Terrain2D::generate_world(int64_t seed) {
+    world_generator->set_seed(static_cast<uint64_t>(seed));
+    item_drops->clear();
+    liquid_system->clear();
+    world_generator->generate_world();
+
+    // Generation bypasses the event stream, relight everything (the view first,
+    // the rest over the following frames)
+    lighting_system->invalidate_all();
+    auto_tiling->invalidate_all();
+    chunk_mesher->invalidate_all();
+    collision_system->invalidate_all();
+}
+
+void Terrain2D::update_active_chunks(Vector2 camera_world_pos) {
+    chunk_manager->update_active_chunks(camera_world_pos);
+    lighting_system->set_focus(WorldCoords::world_to_tile(camera_world_pos));
+    chunk_mesher->set_focus(WorldCoords::world_to_tile(camera_world_pos));
+    collision_system->set_focus(WorldCoords::world_to_tile(camera_world_pos));
+}
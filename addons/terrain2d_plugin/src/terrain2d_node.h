@@ -0,0 +1,216 @@
+#ifndef TERRAIN2D_NODE_H
+#define TERRAIN2D_NODE_H
+
+#include "core/chunk_manager.h"
+#include "core/block_registry.h"
+#include "core/block_tension.h"
+#include "core/block_damage.h"
+#include "core/item_drops.h"
+#include "core/liquid_reactions.h"
+#include "core/liquid_simulation.h"
+#include "core/terrain_collision.h"
+#include "rendering/lighting_2d.h"
+#include "rendering/smooth_lighting.h"
+#include "rendering/chunk_mesher.h"
+#include "rendering/auto_tiling.h"
+#include "utils/thread_pool.h"
+#include "world/biome_system.h"
+#include "world/world_generator.h"
+#include <godot_cpp/classes/node2d.hpp>
+#include <godot_cpp/classes/array_mesh.hpp>
+#include <godot_cpp/variant/rid.hpp>
+#include <godot_cpp/variant/packed_int32_array.hpp>
+#include <godot_cpp/variant/packed_float32_array.hpp>
+#include <godot_cpp/variant/packed_byte_array.hpp>
+#include <godot_cpp/variant/rect2.hpp>
+#include <godot_cpp/variant/rect2i.hpp>
+#include <godot_cpp/variant/dictionary.hpp>
+#include <godot_cpp/variant/packed_vector2_array.hpp>
+#include <godot_cpp/variant/packed_color_array.hpp>
+#include <unordered_map>
+#include <vector>
+
+using namespace godot;
+
+// Main terrain node - owns the terrain systems and drives them every frame
+//
+// Signals:
+//   blocks_changed(events: PackedInt32Array)
+//     Emitted once per frame with every block change of that frame,
+//     4 ints per change: [tile_x, tile_y, (old_type << 16) | new_type, cause | (is_background << 8)]
+//     Cause values match BlockChangeCause (0 placed, 1 destroyed, 2 fell, 3 landed, 4 regenerated, 5 reacted)
+//   chunk_meshes_changed(updated: PackedInt32Array, released: PackedInt32Array)
+//     Emitted at most once per frame, 2 ints (chunk_x, chunk_y) per chunk whose
+//     mesh (get_chunk_mesh) was rebuilt / dropped because the chunk unloaded
+class Terrain2D : public Node2D {
+    GDCLASS(Terrain2D, Node2D)
+
+private:
+    BlockRegistry* block_registry;
+    bool owns_block_registry;       // Created here if the module didn't create the singleton
+
+    ChunkManager* chunk_manager;
+    BiomeSystem* biome_system;
+    WorldGenerator* world_generator;
+    BlockTensionSystem* tension_system;
+    BlockDamageSystem* damage_system;
+    ItemDropSystem* item_drops;
+    LiquidReactionSystem* liquid_reactions;
+    LiquidSystem* liquid_system;
+    LightingSystem* lighting_system;
+    SmoothLighting* smooth_lighting;
+    AutoTileSystem* auto_tiling;
+    ChunkMesher* chunk_mesher;
+    TerrainCollisionSystem* collision_system;
+    ThreadPool* thread_pool;        // Shared worker threads for batched work (lighting rebuilds)
+
+    // Reused every frame
+    PackedInt32Array packed_events;
+    PackedByteArray light_texture;
+    std::vector<DamageResult> damage_results;
+
+    // Published chunk meshes and the buffers they are copied through
+    std::unordered_map<Vector2i, Ref<ArrayMesh>, Vector2iHash> chunk_meshes;
+    PackedVector2Array mesh_vertices;
+    PackedVector2Array mesh_uvs;
+    PackedColorArray mesh_colors;
+    PackedInt32Array mesh_indices;
+    PackedInt32Array updated_mesh_chunks;
+    PackedInt32Array released_mesh_chunks;
+
+    // Physics bodies of the active collision chunks (shape RIDs are reused across rebuilds)
+    struct ChunkBody {
+        RID body;
+        std::vector<RID> shapes;
+    };
+    std::unordered_map<Vector2i, ChunkBody, Vector2iHash> collision_bodies;
+
+protected:
+    static void _bind_methods();
+
+public:
+    Terrain2D();
+    ~Terrain2D();
+
+    void _process(double delta) override;
+
+    // GDScript-callable methods
+    void set_block(Vector2i pos, int block_id, bool background = false);
+    int get_block(Vector2i pos, bool background = false) const;
+
+    // Multi-tile blocks (BlockResource.size, origin = top-left tile).
+    // place_block only fills air and returns false otherwise; get_block_origin
+    // is the origin of the object covering pos (pos itself for single tiles);
+    // get_chunk_anchors lists the objects whose origin is in a loaded chunk as
+    // [origin_x, origin_y, block_id, background] per object
+    bool place_block(Vector2i pos, int block_id, bool background = false);
+    Vector2i get_block_origin(Vector2i pos, bool background = false) const;
+    PackedInt32Array get_chunk_anchors(Vector2i chunk_pos) const;
+
+    // Player cursor mining, returns number of destroyed blocks
+    int damage_block_3x3(Vector2i center, float damage, int tool_tier = 0);
+
+    // Item drops: MultiMesh buffer (TRANSFORM_2D + custom data, 12 floats per drop)
+    PackedFloat32Array get_item_drop_transforms() const;
+    int get_item_drop_count() const;
+    // Returns (item_id, count) pairs for every drop within radius
+    PackedInt32Array collect_item_drops(Vector2 world_pos, float radius);
+
+    // Liquids (type is a LiquidType value, level 1.0 = full tile)
+    bool add_liquid(Vector2i pos, int type, float amount);
+    float get_liquid_level(Vector2i pos);
+    // Liquid rows (32 cells each) still being simulated
+    int get_active_liquid_count() const;
+
+    // Lighting (0-255) and the highest opaque tile Y of a column (LightingSystem::NO_COLUMN_TOP if open)
+    int get_light_level(Vector2i pos) const;
+    int get_surface_height(int tile_x) const;
+
+    // Colored (RGB) block light from BlockDefinition::light_color, off by default
+    void set_colored_lighting(bool enabled);
+    bool is_colored_lighting() const;
+    // RGB8 light of a tile region (width * height * 3 bytes, row-major) for
+    // Image.create_from_data(w, h, false, Image.FORMAT_RGB8, data)
+    PackedByteArray get_light_texture(Rect2i tile_region);
+
+    // Smooth (per-corner) light of the visible tiles, refreshed every frame
+    void set_light_view(Rect2i tile_rect);
+    int get_corner_light(Vector2i corner_pos) const;
+
+    // Chunk meshes (vertices in pixels from the chunk's top-left corner, so a
+    // MeshInstance2D per chunk sits at chunk_pos * CHUNK_WIDTH * TILE_SIZE_PIXELS).
+    // UVs index an atlas grid: column = autotile pattern (block variant for
+    // blocks without use_autotile), row = block type
+    // (rows <= 0 uses one row per registered type)
+    Ref<ArrayMesh> get_chunk_mesh(Vector2i chunk_pos) const;
+    void set_tile_atlas_grid(int columns, int rows);
+
+    // Terrain collision: one static body per chunk near the camera, solid tiles
+    // merged into rectangles, platforms as one-way shapes (node at the origin)
+    void set_collision_radius(Vector2i chunk_radius);
+    int get_collision_shape_count() const;
+    // Time spent rebuilding collision chunks in the last update
+    int get_collision_update_usec() const;
+
+    // Tile-grid movement for character controllers that don't use physics
+    // bodies (aabb and motion in pixels). move_and_collide_tiles stops at the
+    // first contact: {hit, time, travel, remainder, normal, tile}.
+    // move_and_slide_tiles slides along contacts: {travel, remainder, on_floor,
+    // on_wall, on_ceiling}. Platforms only stop falling boxes; pass
+    // collide_platforms = false to drop through them.
+    Dictionary move_and_collide_tiles(Rect2 aabb, Vector2 motion, bool collide_platforms = true) const;
+    Dictionary move_and_slide_tiles(Rect2 aabb, Vector2 motion, bool collide_platforms = true) const;
+
+    // Tile raycasts (pixels) for mining reach, line of sight, lasers.
+    // raycast_tiles: {hit, tile, normal, distance, position} of the first solid
+    // tile between from and to. raycast_tiles_batch casts from[i] -> to[i] on
+    // the thread pool and returns 5 floats per ray:
+    // [distance (-1 = no hit), tile_x, tile_y, normal_x, normal_y]
+    Dictionary raycast_tiles(Vector2 from, Vector2 to, bool hit_platforms = false) const;
+    PackedFloat32Array raycast_tiles_batch(const PackedVector2Array& from, const PackedVector2Array& to,
+                                           bool hit_platforms = false) const;
+
+    // Blocks of a type within a rectangle of chunks (ore scans), from the
+    // per-chunk type histograms
+    int64_t count_blocks_in_chunks(int block_id, Rect2i chunk_region, bool background = false) const;
+
+    // Edit version of a loaded chunk (-1 if not loaded); compare with a
+    // stored one to find chunks that changed (saving, networking)
+    int64_t get_chunk_edit_version(Vector2i chunk_pos) const;
+
+    // Tiles (world coords) of a chunk layer edited after `version`, empty if
+    // none (layer: 0 foreground, 1 background, 2 light, 3 liquid, 4 autotile)
+    Rect2i get_chunk_changes_since(Vector2i chunk_pos, int64_t version, int layer) const;
+
+    void generate_world(int64_t seed);
+    void update_active_chunks(Vector2 camera_world_pos);
+
+    // C++ access to the systems
+    ChunkManager* get_chunk_manager() const { return chunk_manager; }
+    BlockRegistry* get_block_registry() const { return block_registry; }
+    BlockTensionSystem* get_tension_system() const { return tension_system; }
+    BlockDamageSystem* get_damage_system() const { return damage_system; }
+    ItemDropSystem* get_item_drops() const { return item_drops; }
+    LiquidReactionSystem* get_liquid_reactions() const { return liquid_reactions; }
+    LiquidSystem* get_liquid_system() const { return liquid_system; }
+    LightingSystem* get_lighting_system() const { return lighting_system; }
+    SmoothLighting* get_smooth_lighting() const { return smooth_lighting; }
+    AutoTileSystem* get_auto_tiling() const { return auto_tiling; }
+    ChunkMesher* get_chunk_mesher() const { return chunk_mesher; }
+    TerrainCollisionSystem* get_collision_system() const { return collision_system; }
+    WorldGenerator* get_world_generator() const { return world_generator; }
+    BiomeSystem* get_biome_system() const { return biome_system; }
+
+private:
+    // Hand this frame's block changes to consumers
+    void publish_block_changes();
+
+    // Copy meshes rebuilt by the mesher into their ArrayMesh (main thread only)
+    void publish_chunk_meshes();
+
+    // Register rebuilt collision chunks with the physics server (main thread only)
+    void publish_collision_shapes();
+    void free_chunk_body(ChunkBody& body);
+};
+
+#endif // TERRAIN2D_NODE_H
@@ -0,0 +1,271 @@
+#ifndef FLAT_HASH_MAP_H
+#define FLAT_HASH_MAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// 64-bit finalizer (splitmix64): every key bit reaches every hash bit, so the
+// low bits a power-of-two table indexes with stay spread out even for grid
+// keys that differ in one coordinate only
+inline uint64_t hash_mix64(uint64_t key) {
+    key ^= key >> 30;
+    key *= 0xbf58476d1ce4e5b9ULL;
+    key ^= key >> 27;
+    key *= 0x94d049bb133111ebULL;
+    key ^= key >> 31;
+    return key;
+}
+
+// Hash for integer keys (cell indices, packed ids)
+struct IntegerHash {
+    template <typename T>
+    size_t operator()(T value) const {
+        return static_cast<size_t>(hash_mix64(static_cast<uint64_t>(value)));
+    }
+};
+
+// Probe lengths of a FlatHashMap (distance of each entry from its home slot)
+struct FlatHashMapStats {
+    size_t size;
+    size_t capacity;
+    float average_probe;
+    int max_probe;
+
+    FlatHashMapStats() : size(0), capacity(0), average_probe(0.0f), max_probe(0) {}
+};
+
+// Open-addressing hash map (Robin Hood linear probing)
+// Entries live in one flat array, so a lookup reads a slot or two in a row
+// instead of a bucket plus a heap node. Insertion lets an entry that probed
+// further than the one in a slot take that slot ("rob the rich"), which keeps
+// probe lengths short and even; a lookup stops as soon as it meets an entry
+// closer to home than itself. Erase shifts the following entries back instead
+// of leaving tombstones.
+// Unlike std::unordered_map, inserting or erasing moves entries: references
+// and iterators don't survive either (keep values that must stay put behind
+// a unique_ptr), and entries can't be erased while iterating. Key and Value
+// must be default-constructible; empty slots hold default values.
+template <typename Key, typename Value, typename Hash>
+class FlatHashMap {
+public:
+    using value_type = std::pair<Key, Value>;
+
+private:
+    static constexpr size_t MIN_CAPACITY = 8;
+    static constexpr int MAX_PROBE = 0xFFFF;   // Distances are stored in 16 bits
+    static constexpr size_t NOT_FOUND = ~size_t(0);
+
+    std::vector<value_type> slots;
+    std::vector<uint16_t> distances;    // Per slot: probe distance + 1, 0 = empty
+    size_t entry_count;
+    size_t mask;
+
+    template <typename Map, typename Entry>
+    class Iterator {
+        Map* map;
+        size_t index;
+
+        void skip_empty() {
+            while (index < map->distances.size() && map->distances[index] == 0) {
+                index++;
+            }
+        }
+
+        friend class FlatHashMap;
+
+    public:
+        Iterator(Map* owner, size_t start) : map(owner), index(start) { skip_empty(); }
+
+        Entry& operator*() const { return map->slots[index]; }
+        Entry* operator->() const { return &map->slots[index]; }
+        Iterator& operator++() { index++; skip_empty(); return *this; }
+        bool operator==(const Iterator& other) const { return index == other.index; }
+        bool operator!=(const Iterator& other) const { return index != other.index; }
+    };
+
+public:
+    using iterator = Iterator<FlatHashMap, value_type>;
+    using const_iterator = Iterator<const FlatHashMap, const value_type>;
+
+    FlatHashMap() : entry_count(0), mask(0) {}
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, slots.size()); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, slots.size()); }
+
+    inline size_t size() const { return entry_count; }
+    inline bool empty() const { return entry_count == 0; }
+    inline size_t capacity() const { return slots.size(); }
+
+    iterator find(const Key& key) {
+        const size_t index = find_index(key);
+        return iterator(this, index == NOT_FOUND ? slots.size() : index);
+    }
+
+    const_iterator find(const Key& key) const {
+        const size_t index = find_index(key);
+        return const_iterator(this, index == NOT_FOUND ? slots.size() : index);
+    }
+
+    inline bool contains(const Key& key) const { return find_index(key) != NOT_FOUND; }
+
+    // Insert Value(args...) unless the key is present; the bool is true if inserted
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args) {
+        const size_t found = find_index(key);
+        if (found != NOT_FOUND) {
+            return { iterator(this, found), false };
+        }
+
+        // Grow at 7/8 load
+        if ((entry_count + 1) * 8 > slots.size() * 7) {
+            rehash(slots.empty() ? MIN_CAPACITY : slots.size() * 2);
+        }
+        size_t index = insert_new(value_type(key, Value(std::forward<Args>(args)...)));
+        if (index == NOT_FOUND) {
+            index = find_index(key);    // The table grew on the way
+        }
+        return { iterator(this, index), true };
+    }
+
+    Value& operator[](const Key& key) { return try_emplace(key).first->second; }
+
+    size_t erase(const Key& key) {
+        const size_t index = find_index(key);
+        if (index == NOT_FOUND) {
+            return 0;
+        }
+        erase_at(index);
+        return 1;
+    }
+
+    void erase(const iterator& it) { erase_at(it.index); }
+
+    // Drop all entries (the table keeps its capacity)
+    void clear() {
+        for (size_t i = 0; i < slots.size(); i++) {
+            if (distances[i] != 0) {
+                slots[i] = value_type();
+                distances[i] = 0;
+            }
+        }
+        entry_count = 0;
+    }
+
+    // Drop all entries and free the table
+    void release() {
+        std::vector<value_type>().swap(slots);
+        std::vector<uint16_t>().swap(distances);
+        entry_count = 0;
+        mask = 0;
+    }
+
+    // Make room for `count` entries without growing
+    void reserve(size_t count) {
+        size_t capacity = slots.empty() ? MIN_CAPACITY : slots.size();
+        while (count * 8 > capacity * 7) {
+            capacity *= 2;
+        }
+        if (capacity != slots.size()) {
+            rehash(capacity);
+        }
+    }
+
+    size_t get_memory_usage() const {
+        return slots.capacity() * (sizeof(value_type) + sizeof(uint16_t));
+    }
+
+    FlatHashMapStats get_stats() const {
+        FlatHashMapStats stats;
+        stats.size = entry_count;
+        stats.capacity = slots.size();
+        size_t total = 0;
+        for (uint16_t distance : distances) {
+            if (distance != 0) {
+                total += distance - 1;
+                stats.max_probe = distance - 1 > stats.max_probe ? distance - 1 : stats.max_probe;
+            }
+        }
+        stats.average_probe = entry_count > 0 ? static_cast<float>(total) / entry_count : 0.0f;
+        return stats;
+    }
+
+private:
+    inline size_t find_index(const Key& key) const {
+        if (entry_count == 0) {
+            return NOT_FOUND;
+        }
+        size_t index = Hash()(key) & mask;
+        for (int distance = 1; distance <= distances[index]; distance++) {
+            if (distances[index] == distance && slots[index].first == key) {
+                return index;
+            }
+            index = (index + 1) & mask;
+        }
+        return NOT_FOUND;
+    }
+
+    // Place a key known to be absent; returns its slot, or NOT_FOUND if a
+    // probe ran past MAX_PROBE and the table had to grow first (only a hash
+    // that sends tens of thousands of keys to one slot gets there)
+    size_t insert_new(value_type&& entry) {
+        size_t index = Hash()(entry.first) & mask;
+        size_t placed = NOT_FOUND;
+        int distance = 1;
+        while (distances[index] != 0) {
+            // Richer entry (closer to home) gives its slot up
+            if (distances[index] < distance) {
+                std::swap(entry, slots[index]);
+                const int displaced = distances[index];
+                distances[index] = static_cast<uint16_t>(distance);
+                distance = displaced;
+                if (placed == NOT_FOUND) {
+                    placed = index;
+                }
+            }
+            index = (index + 1) & mask;
+            if (++distance > MAX_PROBE) {
+                rehash(slots.size() * 2);
+                insert_new(std::move(entry));
+                return NOT_FOUND;
+            }
+        }
+        slots[index] = std::move(entry);
+        distances[index] = static_cast<uint16_t>(distance);
+        entry_count++;
+        return placed == NOT_FOUND ? index : placed;
+    }
+
+    void erase_at(size_t index) {
+        // Pull the following entries of the run one slot back
+        size_t next = (index + 1) & mask;
+        while (distances[next] > 1) {
+            slots[index] = std::move(slots[next]);
+            distances[index] = distances[next] - 1;
+            index = next;
+            next = (next + 1) & mask;
+        }
+        slots[index] = value_type();
+        distances[index] = 0;
+        entry_count--;
+    }
+
+    void rehash(size_t new_capacity) {
+        std::vector<value_type> old_slots(new_capacity);
+        std::vector<uint16_t> old_distances(new_capacity, 0);
+        old_slots.swap(slots);
+        old_distances.swap(distances);
+        mask = new_capacity - 1;
+        entry_count = 0;
+        for (size_t i = 0; i < old_slots.size(); i++) {
+            if (old_distances[i] != 0) {
+                insert_new(std::move(old_slots[i]));
+            }
+        }
+    }
+};
+
+#endif // FLAT_HASH_MAP_H
@@ -0,0 +1,100 @@
+#include "thread_pool.h"
+#include <algorithm>
+
+ThreadPool::ThreadPool(int thread_count)
+    : job(nullptr)
+    , job_count(0)
+    , next_index(0)
+    , busy_workers(0)
+    , batch_id(0)
+    , stopping(false)
+{
+    if (thread_count < 0) {
+        thread_count = std::max(static_cast<int>(std::thread::hardware_concurrency()) - 1, 0);
+    }
+
+    threads.reserve(thread_count);
+    for (int i = 0; i < thread_count; i++) {
+        threads.emplace_back(&ThreadPool::worker_loop, this, i + 1);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    work_ready.notify_all();
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+void ThreadPool::parallel_for(size_t count, const Job& fn) {
+    if (count == 0) {
+        return;
+    }
+
+    // Nothing to share - run inline
+    if (threads.empty() || count == 1) {
+        for (size_t i = 0; i < count; i++) {
+            fn(i, 0);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = &fn;
+        job_count = count;
+        next_index.store(0, std::memory_order_relaxed);
+        busy_workers = static_cast<int>(threads.size());
+        batch_id++;
+    }
+    work_ready.notify_all();
+
+    run_indices(fn, count, 0);
+
+    // Workers may still be finishing their last index
+    std::unique_lock<std::mutex> lock(mutex);
+    work_done.wait(lock, [this]() { return busy_workers == 0; });
+    job = nullptr;
+}
+
+void ThreadPool::worker_loop(int worker) {
+    uint64_t seen_batch = 0;
+
+    while (true) {
+        const Job* fn;
+        size_t count;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            work_ready.wait(lock, [this, seen_batch]() { return stopping || batch_id != seen_batch; });
+            if (stopping) {
+                return;
+            }
+            seen_batch = batch_id;
+            fn = job;
+            count = job_count;
+        }
+
+        run_indices(*fn, count, worker);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            busy_workers--;
+        }
+        work_done.notify_one();
+    }
+}
+
+void ThreadPool::run_indices(const Job& fn, size_t count, int worker) {
+    while (true) {
+        size_t index = next_index.fetch_add(1, std::memory_order_relaxed);
+        if (index >= count) {
+            return;
+        }
+        fn(index, worker);
+    }
+}
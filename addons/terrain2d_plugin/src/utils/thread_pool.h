@@ -0,0 +1,59 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed pool of worker threads for data-parallel batches
+// parallel_for hands out indices one at a time from an atomic counter and
+// returns once every index has run; the calling thread works on the batch too
+// (as worker 0), so a pool with no extra threads simply runs it inline.
+// Jobs get their worker number so they can keep per-worker scratch buffers.
+class ThreadPool {
+public:
+    using Job = std::function<void(size_t index, int worker)>;
+
+private:
+    std::vector<std::thread> threads;
+
+    std::mutex mutex;
+    std::condition_variable work_ready;
+    std::condition_variable work_done;
+
+    // Current batch (guarded by mutex, next_index is claimed lock-free)
+    const Job* job;
+    size_t job_count;
+    std::atomic<size_t> next_index;
+    int busy_workers;
+    uint64_t batch_id;
+    bool stopping;
+
+public:
+    // thread_count = extra worker threads (-1 = hardware threads - 1)
+    explicit ThreadPool(int thread_count = -1);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Workers available to a batch, including the calling thread
+    int get_worker_count() const { return static_cast<int>(threads.size()) + 1; }
+
+    // Run job(i, worker) for every i in [0, count) and wait for all of them
+    // (not reentrant: jobs must not call parallel_for)
+    void parallel_for(size_t count, const Job& fn);
+
+private:
+    void worker_loop(int worker);
+
+    // Claim and run indices of the current batch until none are left
+    void run_indices(const Job& fn, size_t count, int worker);
+};
+
+#endif // THREAD_POOL_H
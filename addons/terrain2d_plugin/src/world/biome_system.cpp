@@ -142,9 +142,7 @@ void BiomeSystem::generate_biome_map() {
 }
 
 BiomeType BiomeSystem::get_biome_at(int world_x) const {
-    // Wrap X
-    while (world_x < 0) world_x += WORLD_WIDTH;
-    world_x = world_x % WORLD_WIDTH;
+    world_x = WorldCoords::wrap_x(world_x);
 
     auto it = biome_map.find(world_x);
     if (it != biome_map.end()) {
@@ -30,6 +30,11 @@ struct Block2D {
         EMITS_LIGHT     = 1 << 7   // Emits light
     };
 
+    // Multi-tile blocks (BlockDefinition::size above 1x1) put their type in
+    // every tile they cover; metadata holds the tile's offset from the
+    // object's origin (top-left tile) as x | y << 2, so they span up to 4x4
+    static constexpr int MAX_PART_SIZE = 4;
+
     Block2D() : type_id(0), variant(0), metadata(0), flags(0) {}
 
     inline bool has_flag(Flags flag) const { return (flags & flag) != 0; }
@@ -37,6 +42,9 @@ struct Block2D {
         if (value) flags |= flag;
         else flags &= ~flag;
     }
+
+    inline Vector2i get_part_offset() const { return Vector2i(metadata & 3, metadata >> 2); }
+    inline void set_part_offset(Vector2i offset) { metadata = (offset.x & 3) | ((offset.y & 3) << 2); }
 };
 
 // Block health data (stored separately for memory efficiency)
@@ -61,7 +69,7 @@ struct BlockHealth {
 struct BlockDefinition {
     uint16_t id;                          // Unique block ID
     String name;                          // Block name
-    Vector2i size;                        // Size in tiles (1x1, 2x3, etc.)
+    Vector2i size;                        // Size in tiles (1x1, 2x3, etc.; up to Block2D::MAX_PART_SIZE)
 
     // Health and damage properties
     float max_health;                     // Maximum health (default 100)
@@ -88,6 +96,7 @@ struct BlockDefinition {
     Color light_color;                    // Color of emitted light
 
     // Special properties
+    bool is_solid;                        // Collides with bodies (torches and decorations don't)
     bool is_door;                         // Door block
     bool is_chest;                        // Storage container
     bool is_platform;                     // One-way platform
@@ -117,6 +126,7 @@ struct BlockDefinition {
         , light_opacity(255)
         , light_emission(0)
         , light_color(Color(1, 1, 1))
+        , is_solid(true)
         , is_door(false)
         , is_chest(false)
         , is_platform(false)
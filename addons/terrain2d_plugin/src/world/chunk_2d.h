@@ -2,33 +2,65 @@
 #define CHUNK_2D_H
 
 #include "block_data.h"
+#include "world_constants.h"
+#include "chunk_health.h"
+#include "chunk_liquid.h"
+#include "chunk_color_light.h"
+#include "chunk_occupancy.h"
+#include "chunk_blocks.h"
+#include "chunk_anchors.h"
+#include "chunk_edits.h"
+#include "../utils/flat_hash_map.h"
 #include <godot_cpp/core/defs.hpp>
 #include <godot_cpp/variant/vector2i.hpp>
 #include <unordered_map>
 #include <array>
+#include <memory>
 
 using namespace godot;
 
-// Hash function for Vector2i (for unordered_map)
+// Hash function for Vector2i (tile and chunk keys)
+// Packs both coordinates into 64 bits and mixes them, so neighboring cells
+// spread over the whole table instead of colliding like x ^ (y << 1) does
 struct Vector2iHash {
     std::size_t operator()(const Vector2i& v) const {
-        return std::hash<int>()(v.x) ^ (std::hash<int>()(v.y) << 1);
+        const uint64_t packed = (static_cast<uint64_t>(static_cast<uint32_t>(v.x)) << 32) | static_cast<uint32_t>(v.y);
+        return static_cast<std::size_t>(hash_mix64(packed));
     }
 };
 
-// Chunk constants
-constexpr int CHUNK_WIDTH = 32;
-constexpr int CHUNK_HEIGHT = 32;
-constexpr int CHUNK_SIZE = CHUNK_WIDTH * CHUNK_HEIGHT;
+// Autotile pattern of a tile that doesn't blend (air, use_autotile off)
+constexpr uint8_t AUTOTILE_NONE = 0xFF;
 
 class Chunk2D {
 public:
+    // Block layers (row-major type / flag planes; write through set_block)
+    ChunkBlockPlane foreground;
+    ChunkBlockPlane background;
+
     // Chunk data arrays (separate for cache efficiency)
-    std::array<std::array<Block2D, CHUNK_HEIGHT>, CHUNK_WIDTH> foreground;
-    std::array<std::array<Block2D, CHUNK_HEIGHT>, CHUNK_WIDTH> background;
-    std::array<std::array<uint8_t, CHUNK_HEIGHT>, CHUNK_WIDTH> lighting;
+    std::array<std::array<uint8_t, CHUNK_HEIGHT>, CHUNK_WIDTH> lighting;     // Final light (rendering)
+    std::array<std::array<uint8_t, CHUNK_HEIGHT>, CHUNK_WIDTH> sky_light;    // Skylight reaching each tile
+    std::array<std::array<uint8_t, CHUNK_HEIGHT>, CHUNK_WIDTH> block_light;  // Light from torches, lava, ...
+
+    // 47-tile autotile pattern per tile (AUTOTILE_NONE if the tile doesn't blend)
+    std::array<std::array<uint8_t, CHUNK_HEIGHT>, CHUNK_WIDTH> foreground_autotile;
+    std::array<std::array<uint8_t, CHUNK_HEIGHT>, CHUNK_WIDTH> background_autotile;
+
+    // Foreground occupancy per row for tile collision (bit x = column x),
+    // kept current by ChunkManager::set_block_at_tile
+    std::array<uint32_t, CHUNK_HEIGHT> solid_rows;
+    std::array<uint32_t, CHUNK_HEIGHT> platform_rows;     // One-way platforms
+    uint32_t collision_row_summary;     // Bit y set if row y holds any solid or platform tile
 
-    // Liquid data (stored separately, sparse)
+    // Non-air rows, flag counts and type histogram per layer (kept by set_block)
+    ChunkOccupancy foreground_occupancy;
+    ChunkOccupancy background_occupancy;
+
+    // Multi-tile objects with their origin in this chunk (kept by ChunkManager)
+    ChunkAnchorIndex anchors;
+
+    // Liquid cell value (returned by get_liquid)
     struct LiquidCell {
         LiquidType type;
         float level;        // 0.0 to 1.0+ (can exceed for pressure)
@@ -36,55 +68,114 @@ public:
         LiquidCell() : type(LIQUID_NONE), level(0.0f) {}
         LiquidCell(LiquidType t, float l) : type(t), level(l) {}
     };
-    std::unordered_map<Vector2i, LiquidCell, Vector2iHash> liquids;
 
-    // Block health (sparse - only damaged blocks stored)
-    std::unordered_map<Vector2i, BlockHealth, Vector2iHash> block_health;
+    // Liquid data (dense grid, only allocated while the chunk holds liquid)
+    std::unique_ptr<ChunkLiquidGrid> liquid;
+
+    // Colored block light (only allocated while colored lighting is enabled)
+    std::unique_ptr<ChunkColorLight> color_light;
+
+    // Block health (sparse until many blocks are damaged, then dense + quantized)
+    ChunkHealthStore block_health;
 
     // Chunk metadata
     Vector2i chunk_position;    // Position in chunk coordinates
     bool is_generated;          // Has been generated
-    bool dirty_mesh;            // Needs mesh rebuild
-    bool dirty_lighting;        // Needs lighting recalc
-    bool dirty_background;      // Background needs update
+    bool dirty_lighting;        // Needs a full lighting rebuild (edits relight through block events)
+    bool dirty_autotile;        // Needs a full autotile pass (edits retile through block events)
+
+    // Edit tracking: every edit bumps edit_version (save / network change
+    // detection) and is recorded with its dirty rectangle in its layer's
+    // history, so each consumer rebuilds only what changed since it last looked
+    uint32_t edit_version;
+    std::array<ChunkLayerEdits, CHUNK_LAYER_COUNT> layer_edits;
+
+    // Loaded chunks of the 3x3 block around this one, index (dy + 1) * 3 + dx + 1
+    // (center = this, X wraps, nullptr where not loaded); kept by ChunkManager
+    std::array<Chunk2D*, 9> neighborhood;
 
     Chunk2D(Vector2i pos)
         : chunk_position(pos)
         , is_generated(false)
-        , dirty_mesh(true)
         , dirty_lighting(true)
-        , dirty_background(true)
+        , dirty_autotile(true)
+        , edit_version(0)
     {
-        // Initialize all blocks to air (type 0)
+        neighborhood.fill(nullptr);
+        neighborhood[4] = this;
+
+        // Blocks start as air (the planes clear themselves)
         for (int x = 0; x < CHUNK_WIDTH; x++) {
             for (int y = 0; y < CHUNK_HEIGHT; y++) {
-                foreground[x][y] = Block2D();
-                background[x][y] = Block2D();
                 lighting[x][y] = 0;
+                sky_light[x][y] = 0;
+                block_light[x][y] = 0;
+                foreground_autotile[x][y] = AUTOTILE_NONE;
+                background_autotile[x][y] = AUTOTILE_NONE;
             }
         }
+        solid_rows.fill(0);
+        platform_rows.fill(0);
+        collision_row_summary = 0;
     }
 
-    // Block access with bounds checking
-    inline Block2D* get_block(Vector2i local_pos, bool is_background = false) {
-        if (local_pos.x < 0 || local_pos.x >= CHUNK_WIDTH ||
-            local_pos.y < 0 || local_pos.y >= CHUNK_HEIGHT) {
-            return nullptr;
+    // Neighbor chunk (dx, dy in -1..1; nullptr if not loaded)
+    inline Chunk2D* get_neighbor(int dx, int dy) { return neighborhood[(dy + 1) * 3 + dx + 1]; }
+    inline const Chunk2D* get_neighbor(int dx, int dy) const { return neighborhood[(dy + 1) * 3 + dx + 1]; }
+    inline void set_neighbor(int dx, int dy, Chunk2D* chunk) { neighborhood[(dy + 1) * 3 + dx + 1] = chunk; }
+
+    // Block at a local position up to one chunk outside this one, through the
+    // neighbor pointers (invalid if that chunk isn't loaded)
+    inline BlockView get_block_around(int x, int y, bool is_background = false) const {
+        const int dx = (x >= CHUNK_WIDTH) - (x < 0);
+        const int dy = (y >= CHUNK_HEIGHT) - (y < 0);
+        const Chunk2D* chunk = get_neighbor(dx, dy);
+        if (!chunk) {
+            return BlockView();
+        }
+        x -= dx * CHUNK_WIDTH;
+        y -= dy * CHUNK_HEIGHT;
+        return is_background ? chunk->background.get(x, y) : chunk->foreground.get(x, y);
+    }
+
+    // Copy a per-tile value of this chunk plus a one-tile ghost border from
+    // the neighbors, so stencils can read it without bounds checks:
+    // out[r][c] = field(chunk, x, y) for local tile (c - 1, r - 1) in rows
+    // first_row..last_row of a (CHUNK_HEIGHT + 2) x (CHUNK_WIDTH + 2) grid,
+    // `missing` where no chunk is loaded
+    template <typename Grid, typename Field, typename T>
+    inline void gather_ghost_rows(Grid& out, int first_row, int last_row, const Field& field, T missing) const {
+        for (int r = first_row; r <= last_row; r++) {
+            const int dy = (r > CHUNK_HEIGHT) - (r < 1);
+            const int y = r - 1 - dy * CHUNK_HEIGHT;
+            const Chunk2D* left = get_neighbor(-1, dy);
+            const Chunk2D* middle = get_neighbor(0, dy);
+            const Chunk2D* right = get_neighbor(1, dy);
+            auto& row = out[r];
+            row[0] = left ? field(*left, CHUNK_WIDTH - 1, y) : missing;
+            for (int x = 0; x < CHUNK_WIDTH; x++) {
+                row[x + 1] = middle ? field(*middle, x, y) : missing;
+            }
+            row[CHUNK_WIDTH + 1] = right ? field(*right, 0, y) : missing;
         }
-        return is_background ? &background[local_pos.x][local_pos.y]
-                             : &foreground[local_pos.x][local_pos.y];
     }
 
-    inline const Block2D* get_block(Vector2i local_pos, bool is_background = false) const {
+    inline static bool is_local_valid(Vector2i local_pos) {
+        return local_pos.x >= 0 && local_pos.x < CHUNK_WIDTH &&
+               local_pos.y >= 0 && local_pos.y < CHUNK_HEIGHT;
+    }
+
+    // Block access with bounds checking (invalid view outside the chunk)
+    inline BlockView get_block(Vector2i local_pos, bool is_background = false) const {
         if (local_pos.x < 0 || local_pos.x >= CHUNK_WIDTH ||
             local_pos.y < 0 || local_pos.y >= CHUNK_HEIGHT) {
-            return nullptr;
+            return BlockView();
         }
-        return is_background ? &background[local_pos.x][local_pos.y]
-                             : &foreground[local_pos.x][local_pos.y];
+        return is_background ? background.get(local_pos.x, local_pos.y)
+                             : foreground.get(local_pos.x, local_pos.y);
     }
 
-    // Set block and mark dirty
+    // Set block and record the edit
     inline void set_block(Vector2i local_pos, const Block2D& block, bool is_background = false) {
         if (local_pos.x < 0 || local_pos.x >= CHUNK_WIDTH ||
             local_pos.y < 0 || local_pos.y >= CHUNK_HEIGHT) {
@@ -92,61 +183,88 @@ public:
         }
 
         if (is_background) {
-            background[local_pos.x][local_pos.y] = block;
-            dirty_background = true;
+            background_occupancy.replace(local_pos.x, local_pos.y, background.get(local_pos.x, local_pos.y), block);
+            background.set(local_pos.x, local_pos.y, block);
+            mark_edited(CHUNK_LAYER_BACKGROUND, local_pos.x, local_pos.y);
         } else {
-            foreground[local_pos.x][local_pos.y] = block;
-            dirty_mesh = true;
+            foreground_occupancy.replace(local_pos.x, local_pos.y, foreground.get(local_pos.x, local_pos.y), block);
+            foreground.set(local_pos.x, local_pos.y, block);
+            mark_edited(CHUNK_LAYER_FOREGROUND, local_pos.x, local_pos.y);
         }
-        dirty_lighting = true;
     }
 
     // Block health management
-    inline BlockHealth* get_health(Vector2i local_pos) {
-        auto it = block_health.find(local_pos);
-        if (it != block_health.end()) {
-            return &it->second;
+    // Returns false if the block is undamaged (at full health)
+    inline bool get_health(Vector2i local_pos, BlockHealth& out, float max_health = 100.0f) const {
+        if (!is_local_valid(local_pos)) {
+            return false;
         }
-        return nullptr;
+        return block_health.get(local_pos, out, max_health);
     }
 
     inline void set_health(Vector2i local_pos, float health, float max_health = 100.0f) {
-        if (health >= max_health) {
-            // Full health - remove from sparse map
-            block_health.erase(local_pos);
-        } else {
-            block_health[local_pos] = BlockHealth(max_health);
-            block_health[local_pos].current_health = health;
+        if (!is_local_valid(local_pos)) {
+            return;
         }
+        block_health.set(local_pos, health, max_health);
     }
 
     inline void damage_block(Vector2i local_pos, float damage, float max_health = 100.0f) {
-        auto it = block_health.find(local_pos);
-        if (it != block_health.end()) {
-            it->second.current_health -= damage;
-        } else {
-            // First damage - create health entry
-            block_health[local_pos] = BlockHealth(max_health);
-            block_health[local_pos].current_health = max_health - damage;
+        if (!is_local_valid(local_pos)) {
+            return;
         }
+        block_health.damage(local_pos, damage, max_health);
     }
 
     // Liquid management
-    inline LiquidCell* get_liquid(Vector2i local_pos) {
-        auto it = liquids.find(local_pos);
-        if (it != liquids.end()) {
-            return &it->second;
+    // Returns false if the cell holds no liquid
+    inline bool get_liquid(Vector2i local_pos, LiquidCell& out) const {
+        if (!liquid || !is_local_valid(local_pos)) {
+            return false;
+        }
+        int index = ChunkLiquidGrid::index_of(local_pos);
+        if (liquid->level[index] <= 0.0f) {
+            return false;
         }
-        return nullptr;
+        out = LiquidCell(static_cast<LiquidType>(liquid->type[index]), liquid->level[index]);
+        return true;
     }
 
     inline void set_liquid(Vector2i local_pos, LiquidType type, float level) {
-        if (level <= 0.0f || type == LIQUID_NONE) {
-            liquids.erase(local_pos);
-        } else {
-            liquids[local_pos] = LiquidCell(type, level);
+        if (!is_local_valid(local_pos)) {
+            return;
+        }
+        bool empty = level <= 0.0f || type == LIQUID_NONE;
+        if (!liquid) {
+            if (empty) {
+                return;
+            }
+            liquid = std::make_unique<ChunkLiquidGrid>();
+        }
+        int index = ChunkLiquidGrid::index_of(local_pos);
+        liquid->level[index] = empty ? 0.0f : level;
+        liquid->type[index] = empty ? LIQUID_NONE : type;
+        mark_edited(CHUNK_LAYER_LIQUID, local_pos.x, local_pos.y);
+    }
+
+    inline ChunkLiquidGrid* get_liquid_grid() { return liquid.get(); }
+    inline const ChunkLiquidGrid* get_liquid_grid() const { return liquid.get(); }
+
+    inline ChunkLiquidGrid& ensure_liquid_grid() {
+        if (!liquid) {
+            liquid = std::make_unique<ChunkLiquidGrid>();
         }
-        dirty_mesh = true;
+        return *liquid;
+    }
+
+    // Drop the grid once the chunk holds no liquid
+    inline void release_liquid_grid() { liquid.reset(); }
+
+    inline ChunkColorLight& ensure_color_light() {
+        if (!color_light) {
+            color_light = std::make_unique<ChunkColorLight>();
+        }
+        return *color_light;
     }
 
     // Lighting access
@@ -164,31 +282,64 @@ public:
             return;
         }
         lighting[local_pos.x][local_pos.y] = light_level;
+        mark_edited(CHUNK_LAYER_LIGHT, local_pos.x, local_pos.y);
+    }
+
+    // Record an edit of local tiles (x0, y0)..(x1, y1) inclusive
+    inline void mark_edited(ChunkLayer layer, int x0, int y0, int x1, int y1) {
+        layer_edits[layer].record(++edit_version, x0, y0, x1, y1);
+    }
+
+    inline void mark_edited(ChunkLayer layer, int x, int y) { mark_edited(layer, x, y, x, y); }
+    inline void mark_all_edited(ChunkLayer layer) { mark_edited(layer, 0, 0, CHUNK_WIDTH - 1, CHUNK_HEIGHT - 1); }
+
+    // Version of the last edit of a layer (0 = never edited)
+    inline uint32_t get_layer_version(ChunkLayer layer) const { return layer_edits[layer].get_version(); }
+
+    // Local tiles of a layer edited after version `since` (false if none)
+    inline bool get_changes_since(ChunkLayer layer, uint32_t since, Rect2i& region) const {
+        return layer_edits[layer].get_changes_since(since, region);
     }
 
     // Clear chunk data
     void clear() {
+        foreground.clear();
+        background.clear();
         for (int x = 0; x < CHUNK_WIDTH; x++) {
             for (int y = 0; y < CHUNK_HEIGHT; y++) {
-                foreground[x][y] = Block2D();
-                background[x][y] = Block2D();
                 lighting[x][y] = 0;
+                sky_light[x][y] = 0;
+                block_light[x][y] = 0;
+                foreground_autotile[x][y] = AUTOTILE_NONE;
+                background_autotile[x][y] = AUTOTILE_NONE;
             }
         }
-        liquids.clear();
+        solid_rows.fill(0);
+        platform_rows.fill(0);
+        collision_row_summary = 0;
+        foreground_occupancy.clear();
+        background_occupancy.clear();
+        anchors.clear();
+        liquid.reset();
+        color_light.reset();
         block_health.clear();
         is_generated = false;
-        dirty_mesh = true;
         dirty_lighting = true;
-        dirty_background = true;
+        dirty_autotile = true;
+        for (int layer = 0; layer < CHUNK_LAYER_COUNT; layer++) {
+            mark_all_edited(static_cast<ChunkLayer>(layer));
+        }
     }
 
     // Memory usage estimation
     size_t get_memory_usage() const {
         size_t base = sizeof(Chunk2D);
-        size_t liquid_mem = liquids.size() * (sizeof(Vector2i) + sizeof(LiquidCell));
-        size_t health_mem = block_health.size() * (sizeof(Vector2i) + sizeof(BlockHealth));
-        return base + liquid_mem + health_mem;
+        size_t liquid_mem = liquid ? sizeof(ChunkLiquidGrid) : 0;
+        size_t health_mem = block_health.get_memory_usage();
+        size_t color_mem = color_light ? sizeof(ChunkColorLight) : 0;
+        size_t occupancy_mem = foreground_occupancy.get_memory_usage() + background_occupancy.get_memory_usage();
+        size_t anchor_mem = anchors.get_memory_usage();
+        return base + liquid_mem + health_mem + color_mem + occupancy_mem + anchor_mem;
     }
 };
 
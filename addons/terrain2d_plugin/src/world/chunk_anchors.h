@@ -0,0 +1,50 @@
+#ifndef CHUNK_ANCHORS_H
+#define CHUNK_ANCHORS_H
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// Multi-tile objects (doors, chests, ...) whose origin tile lies in a chunk
+// The object's other tiles may be in neighbor chunks; each of them finds the
+// origin from the offset in its Block2D metadata, so the index only lists
+// origins. Kept by ChunkManager when objects are placed or removed.
+class ChunkAnchorIndex {
+public:
+    struct Anchor {
+        uint8_t x;              // Local origin tile
+        uint8_t y;
+        uint16_t type_id;
+        bool background;
+    };
+
+private:
+    std::vector<Anchor> anchors;    // Unordered
+
+public:
+    inline void add(int x, int y, uint16_t type_id, bool background) {
+        anchors.push_back({ static_cast<uint8_t>(x), static_cast<uint8_t>(y), type_id, background });
+    }
+
+    // Drop the anchor at local (x, y) of a layer (false if there is none)
+    inline bool remove(int x, int y, bool background) {
+        for (size_t i = 0; i < anchors.size(); i++) {
+            const Anchor& anchor = anchors[i];
+            if (anchor.x == x && anchor.y == y && anchor.background == background) {
+                anchors[i] = anchors.back();
+                anchors.pop_back();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    inline const std::vector<Anchor>& get_anchors() const { return anchors; }
+    inline bool empty() const { return anchors.empty(); }
+
+    inline size_t get_memory_usage() const { return anchors.capacity() * sizeof(Anchor); }
+
+    inline void clear() { std::vector<Anchor>().swap(anchors); }
+};
+
+#endif // CHUNK_ANCHORS_H
@@ -0,0 +1,147 @@
+#ifndef CHUNK_BLOCKS_H
+#define CHUNK_BLOCKS_H
+
+#include "block_data.h"
+#include "world_constants.h"
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+using namespace godot;
+
+// A block read from a ChunkBlockPlane, in place of the old Block2D pointer
+// The plane stores no Block2D to point at, so this holds a copy; it tests
+// false where the pointer was nullptr (outside the chunk, chunk not loaded).
+// Blocks are changed through set_block, never through a view.
+class BlockView {
+private:
+    Block2D block;
+    bool valid;
+
+public:
+    BlockView() : valid(false) {}
+    BlockView(const Block2D& b) : block(b), valid(true) {}
+
+    explicit inline operator bool() const { return valid; }
+    inline const Block2D* operator->() const { return &block; }
+    inline const Block2D& operator*() const { return block; }
+
+    // Pointer to the copy (nullptr if invalid), for helpers taking const Block2D*
+    inline const Block2D* get() const { return valid ? &block : nullptr; }
+};
+
+// One block layer of a chunk, split into row-major planes per field
+// (index y * WIDTH + x). Code that needs one field reads one contiguous
+// array instead of striding over 4-byte blocks: a row is 64 bytes of types
+// or 32 bytes of flags, and "which tiles of this row hold this type / have
+// this flag" comes back as a row mask in a few word operations.
+// Still 4 bytes per tile. Block2D stays the interchange type: get / set and
+// the [x][y] read shim pack and unpack it for code that wants whole blocks;
+// whole-chunk questions (any blocks, how many of a type) are ChunkOccupancy's.
+class ChunkBlockPlane {
+public:
+    static constexpr int WIDTH = CHUNK_WIDTH;
+    static constexpr int HEIGHT = CHUNK_HEIGHT;
+    static constexpr int CELL_COUNT = WIDTH * HEIGHT;
+
+private:
+    alignas(64) std::array<uint16_t, CELL_COUNT> types;     // Block2D::type_id
+    alignas(32) std::array<uint8_t, CELL_COUNT> flags;      // Block2D::flags
+    std::array<uint8_t, CELL_COUNT> details;                // variant | metadata << 4
+
+    // Row masks are built a 64-bit word at a time: 8 flag bytes or 4 types
+    // are tested together and their lane bits gathered with one multiply
+    // (little-endian lane order, as on every platform Godot ships on)
+    static inline uint64_t load_word(const void* source) {
+        uint64_t word;
+        std::memcpy(&word, source, sizeof(word));
+        return word;
+    }
+
+    // Bit i set where byte i of word is non-zero
+    static inline uint32_t nonzero_bytes(uint64_t word) {
+        const uint64_t low = 0x7F7F7F7F7F7F7F7FULL;
+        const uint64_t high = (((word & low) + low) | word) & ~low;
+        return static_cast<uint32_t>(((high >> 7) * 0x0002040810204081ULL) >> 49) & 0xFFu;
+    }
+
+    // Bit i set where 16-bit lane i of word is zero
+    static inline uint32_t zero_lanes(uint64_t word) {
+        const uint64_t low = 0x7FFF7FFF7FFF7FFFULL;
+        const uint64_t zero = ~((((word & low) + low) | word) | low);
+        return static_cast<uint32_t>(((zero >> 15) * 0x0000200040008001ULL) >> 45) & 0xFu;
+    }
+
+public:
+    // Column x of the read shim: plane[x][y] returns the block by value
+    class Column {
+    private:
+        const ChunkBlockPlane* plane;
+        int x;
+
+    public:
+        Column(const ChunkBlockPlane* owner, int column) : plane(owner), x(column) {}
+        inline Block2D operator[](int y) const { return plane->get(x, y); }
+    };
+
+    ChunkBlockPlane() { clear(); }
+
+    static inline int index_of(int x, int y) { return y * WIDTH + x; }
+
+    inline Block2D get(int x, int y) const {
+        const int index = index_of(x, y);
+        Block2D block;
+        block.type_id = types[index];
+        block.variant = details[index] & 0x0F;
+        block.metadata = details[index] >> 4;
+        block.flags = flags[index];
+        return block;
+    }
+
+    inline void set(int x, int y, const Block2D& block) {
+        const int index = index_of(x, y);
+        types[index] = block.type_id;
+        details[index] = static_cast<uint8_t>(block.variant | (block.metadata << 4));
+        flags[index] = block.flags;
+    }
+
+    inline Column operator[](int x) const { return Column(this, x); }
+
+    inline uint16_t get_type(int x, int y) const { return types[index_of(x, y)]; }
+    inline uint8_t get_flags(int x, int y) const { return flags[index_of(x, y)]; }
+    inline bool has_flag(int x, int y, Block2D::Flags flag) const { return (flags[index_of(x, y)] & flag) != 0; }
+
+    inline const uint16_t* row_types(int y) const { return types.data() + y * WIDTH; }
+    inline const uint8_t* row_flags(int y) const { return flags.data() + y * WIDTH; }
+
+    // Tiles of row y with any of the flag bits in `mask` set (bit x = column x)
+    inline uint32_t get_flag_row(int y, uint8_t mask) const {
+        static_assert(WIDTH % 8 == 0, "Row masks work on whole 64-bit words");
+        const uint8_t* row = row_flags(y);
+        const uint64_t repeated = 0x0101010101010101ULL * mask;
+        uint32_t bits = 0;
+        for (int x = 0; x < WIDTH; x += 8) {
+            bits |= nonzero_bytes(load_word(row + x) & repeated) << x;
+        }
+        return bits;
+    }
+
+    // Tiles of row y holding type_id (bit x = column x)
+    inline uint32_t get_type_row(int y, uint16_t type_id) const {
+        const uint16_t* row = row_types(y);
+        const uint64_t repeated = 0x0001000100010001ULL * type_id;
+        uint32_t bits = 0;
+        for (int x = 0; x < WIDTH; x += 4) {
+            bits |= zero_lanes(load_word(row + x) ^ repeated) << x;
+        }
+        return bits;
+    }
+
+    inline void clear() {
+        types.fill(0);
+        flags.fill(0);
+        details.fill(0);
+    }
+};
+
+#endif // CHUNK_BLOCKS_H
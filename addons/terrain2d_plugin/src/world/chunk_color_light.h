@@ -0,0 +1,86 @@
+#ifndef CHUNK_COLOR_LIGHT_H
+#define CHUNK_COLOR_LIGHT_H
+
+#include "world_constants.h"
+#include <godot_cpp/variant/color.hpp>
+#include <array>
+#include <algorithm>
+#include <cstdint>
+
+using namespace godot;
+
+// Packed RGB light
+// Three 8-bit channels in one uint32_t, each in its own 10-bit lane
+// (R = bits 0-7, G = 10-17, B = 20-27). The two spare bits above every channel
+// absorb borrows and carries, so light propagation works on all three channels
+// at once with plain integer ops (SWAR) instead of three scalar passes.
+namespace PackedLight {
+    constexpr int LANE_BITS = 10;
+    constexpr uint32_t LANE_LOW = 0x00100401u;          // 1 in every lane
+    constexpr uint32_t LANE_GUARD = LANE_LOW << 8;      // Bit 8 of every lane
+    constexpr uint32_t LANE_CHANNELS = LANE_LOW * 0xFF; // 0xFF in every lane
+
+    inline constexpr uint32_t pack(uint8_t r, uint8_t g, uint8_t b) {
+        return static_cast<uint32_t>(r) | (static_cast<uint32_t>(g) << LANE_BITS) |
+               (static_cast<uint32_t>(b) << (2 * LANE_BITS));
+    }
+
+    // Same value in all three channels
+    inline constexpr uint32_t splat(uint8_t value) {
+        return LANE_LOW * value;
+    }
+
+    inline constexpr uint8_t red(uint32_t light) { return light & 0xFF; }
+    inline constexpr uint8_t green(uint32_t light) { return (light >> LANE_BITS) & 0xFF; }
+    inline constexpr uint8_t blue(uint32_t light) { return (light >> (2 * LANE_BITS)) & 0xFF; }
+
+    // Per-channel max(a - b, 0)
+    inline constexpr uint32_t sub_sat(uint32_t a, uint32_t b) {
+        uint32_t diff = (a | LANE_GUARD) - b;                  // Guard bit survives where a >= b
+        return diff & (((diff & LANE_GUARD) >> 8) * 0xFF);
+    }
+
+    // Per-channel max(a, b)
+    inline constexpr uint32_t max(uint32_t a, uint32_t b) {
+        return b + sub_sat(a, b);
+    }
+
+    // 0xFF in every lane where the channel is non-zero
+    inline constexpr uint32_t nonzero_mask(uint32_t light) {
+        return (((light + LANE_CHANNELS) & LANE_GUARD) >> 8) * 0xFF;
+    }
+
+    // Brightest channel (monochrome light level)
+    inline constexpr uint8_t intensity(uint32_t light) {
+        return std::max(std::max(red(light), green(light)), blue(light));
+    }
+
+    // Emission tinted by a color (components clamped to 0-1)
+    inline uint32_t from_color(const Color& color, uint8_t emission) {
+        auto channel = [emission](float c) {
+            return static_cast<uint8_t>(std::min(std::max(c, 0.0f), 1.0f) * emission + 0.5f);
+        };
+        return pack(channel(color.r), channel(color.g), channel(color.b));
+    }
+}
+
+// Colored block light of one chunk
+// Only allocated while colored lighting is enabled; Chunk2D keeps a null
+// pointer otherwise. Column-major like the other light planes.
+class ChunkColorLight {
+public:
+    static constexpr int WIDTH = CHUNK_WIDTH;
+    static constexpr int HEIGHT = CHUNK_HEIGHT;
+
+    std::array<std::array<uint32_t, HEIGHT>, WIDTH> block_light;   // PackedLight values
+
+    ChunkColorLight() { clear(); }
+
+    inline void clear() {
+        for (auto& column : block_light) {
+            column.fill(0);
+        }
+    }
+};
+
+#endif // CHUNK_COLOR_LIGHT_H
@@ -0,0 +1,99 @@
+#ifndef CHUNK_EDITS_H
+#define CHUNK_EDITS_H
+
+#include "world_constants.h"
+#include <godot_cpp/variant/rect2i.hpp>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+using namespace godot;
+
+// Parts of a chunk whose edits are tracked separately
+enum ChunkLayer {
+    CHUNK_LAYER_FOREGROUND = 0,
+    CHUNK_LAYER_BACKGROUND,
+    CHUNK_LAYER_LIGHT,          // Final light plane
+    CHUNK_LAYER_LIQUID,
+    CHUNK_LAYER_AUTOTILE,       // Autotile patterns of either layer
+    CHUNK_LAYER_COUNT
+};
+
+// Spans of edits remembered per layer (older changes report the whole chunk)
+constexpr int CHUNK_EDIT_HISTORY = 4;
+
+// Edit history of one chunk layer
+// Every edit is stamped with the chunk's edit version and grows the dirty
+// rectangle of the newest span. Consumers keep the version they last
+// processed and ask for the rectangle of everything after it, so each one
+// rebuilds only what changed since it last looked, independently of the
+// others. A query closes the newest span (later edits open a new one), which
+// keeps the spans aligned with the versions consumers have seen; a consumer
+// further behind than the history gets the whole chunk.
+class ChunkLayerEdits {
+private:
+    struct Span {
+        uint32_t last_version;      // Covers (previous span's last_version, last_version]
+        uint8_t min_x, min_y, max_x, max_y;
+    };
+
+    std::array<Span, CHUNK_EDIT_HISTORY> spans;     // Oldest first
+    int span_count;
+    uint32_t history_start;         // Edits up to this version are forgotten
+    uint32_t version;               // Version of the last edit (0 = never edited)
+    mutable bool sealed;            // Newest span was reported, the next edit opens a new one
+
+public:
+    ChunkLayerEdits() : span_count(0), history_start(0), version(0), sealed(false) {}
+
+    inline uint32_t get_version() const { return version; }
+
+    // Record an edit of local tiles (x0, y0)..(x1, y1) inclusive, stamped with edit_version
+    inline void record(uint32_t edit_version, int x0, int y0, int x1, int y1) {
+        if (span_count == 0 || sealed) {
+            if (span_count == CHUNK_EDIT_HISTORY) {
+                history_start = spans[0].last_version;
+                std::copy(spans.begin() + 1, spans.end(), spans.begin());
+                span_count--;
+            }
+            Span& span = spans[span_count++];
+            span.min_x = static_cast<uint8_t>(x0);
+            span.min_y = static_cast<uint8_t>(y0);
+            span.max_x = static_cast<uint8_t>(x1);
+            span.max_y = static_cast<uint8_t>(y1);
+            sealed = false;
+        } else {
+            Span& span = spans[span_count - 1];
+            span.min_x = std::min(span.min_x, static_cast<uint8_t>(x0));
+            span.min_y = std::min(span.min_y, static_cast<uint8_t>(y0));
+            span.max_x = std::max(span.max_x, static_cast<uint8_t>(x1));
+            span.max_y = std::max(span.max_y, static_cast<uint8_t>(y1));
+        }
+        spans[span_count - 1].last_version = edit_version;
+        version = edit_version;
+    }
+
+    // Local tiles changed after `since` (false if nothing changed)
+    inline bool get_changes_since(uint32_t since, Rect2i& region) const {
+        if (since >= version) {
+            return false;
+        }
+        sealed = true;
+        if (since < history_start) {
+            region = Rect2i(0, 0, CHUNK_WIDTH, CHUNK_HEIGHT);
+            return true;
+        }
+
+        int min_x = CHUNK_WIDTH, min_y = CHUNK_HEIGHT, max_x = -1, max_y = -1;
+        for (int i = span_count - 1; i >= 0 && spans[i].last_version > since; i--) {
+            min_x = std::min(min_x, static_cast<int>(spans[i].min_x));
+            min_y = std::min(min_y, static_cast<int>(spans[i].min_y));
+            max_x = std::max(max_x, static_cast<int>(spans[i].max_x));
+            max_y = std::max(max_y, static_cast<int>(spans[i].max_y));
+        }
+        region = Rect2i(min_x, min_y, max_x - min_x + 1, max_y - min_y + 1);
+        return true;
+    }
+};
+
+#endif // CHUNK_EDITS_H
@@ -0,0 +1,212 @@
+#ifndef CHUNK_HEALTH_H
+#define CHUNK_HEALTH_H
+
+#include "block_data.h"
+#include "world_constants.h"
+#include "../utils/flat_hash_map.h"
+#include <godot_cpp/variant/vector2i.hpp>
+#include <array>
+#include <memory>
+#include <cstdint>
+#include <cmath>
+
+using namespace godot;
+
+// Adaptive per-chunk block health storage
+// A few damaged blocks live in a sparse flat hashmap. Once enough of the chunk is
+// damaged (explosions, 3x3 mining) the store is promoted to a dense 32x32
+// array of quantized damage, which also allows bulk row updates.
+//
+// Dense cells hold the damage taken as a fraction of max health:
+// 0 = undamaged, 65535 = no health left. Max health is supplied by the caller
+// (it comes from the block definition), so a cell costs 2 bytes.
+class ChunkHealthStore {
+public:
+    // Damaged block count at which the sparse map is promoted to dense
+    // (64 entries need a 128-slot table, about as much memory as the 2 KB dense array)
+    static constexpr size_t DENSE_PROMOTE_THRESHOLD = 64;
+
+    static constexpr uint16_t QUANTIZED_MAX = 0xFFFF;
+
+    static constexpr int WIDTH = CHUNK_WIDTH;
+    static constexpr int HEIGHT = CHUNK_HEIGHT;
+    static constexpr int CELL_COUNT = WIDTH * HEIGHT;
+
+    ChunkHealthStore() : dense_count(0) {}
+
+    // Quantize damage relative to max health (rounded up so damage is never lost)
+    static inline uint16_t quantize_damage(float damage, float max_health) {
+        if (damage <= 0.0f || max_health <= 0.0f) {
+            return 0;
+        }
+        float q = std::ceil(damage / max_health * QUANTIZED_MAX);
+        return q >= QUANTIZED_MAX ? QUANTIZED_MAX : static_cast<uint16_t>(q);
+    }
+
+    // Get health of a damaged block
+    // Returns false (and leaves out untouched) if the block is undamaged
+    inline bool get(Vector2i local_pos, BlockHealth& out, float max_health = 100.0f) const {
+        if (dense) {
+            uint16_t q = (*dense)[index_of(local_pos)];
+            if (q == 0) {
+                return false;
+            }
+            out.max_health = max_health;
+            out.current_health = max_health * (1.0f - static_cast<float>(q) / QUANTIZED_MAX);
+            return true;
+        }
+
+        auto it = sparse.find(index_of(local_pos));
+        if (it == sparse.end()) {
+            return false;
+        }
+        out = it->second;
+        return true;
+    }
+
+    inline void set(Vector2i local_pos, float health, float max_health = 100.0f) {
+        if (dense) {
+            store_dense(index_of(local_pos), health_to_quantized(health, max_health));
+            return;
+        }
+
+        if (health >= max_health) {
+            // Full health - remove from sparse map
+            sparse.erase(index_of(local_pos));
+            return;
+        }
+
+        BlockHealth& entry = sparse[index_of(local_pos)];
+        entry = BlockHealth(max_health);
+        entry.current_health = health;
+        promote_if_needed();
+    }
+
+    inline void damage(Vector2i local_pos, float damage, float max_health = 100.0f) {
+        if (dense) {
+            size_t index = index_of(local_pos);
+            uint32_t q = (*dense)[index] + quantize_damage(damage, max_health);
+            store_dense(index, q > QUANTIZED_MAX ? QUANTIZED_MAX : static_cast<uint16_t>(q));
+            return;
+        }
+
+        auto [it, inserted] = sparse.try_emplace(index_of(local_pos), max_health);
+        it->second.current_health -= damage;
+        if (inserted) {
+            promote_if_needed();
+        }
+    }
+
+    // Bulk damage for one row span [x_begin, x_end) of local row y
+    // damage_q holds quantized damage per tile (indexed from x_begin)
+    // Returns a bitmask (bit x) of tiles whose health reached zero
+    // Forces the dense representation; the loops are written to auto-vectorize
+    uint32_t add_row_damage(int y, int x_begin, int x_end, const uint16_t* damage_q) {
+        if (x_begin < 0) x_begin = 0;
+        if (x_end > WIDTH) x_end = WIDTH;
+        if (y < 0 || y >= HEIGHT || x_begin >= x_end) {
+            return 0;
+        }
+
+        make_dense();
+        uint16_t* row = dense->data() + y * WIDTH;
+        const int count = x_end - x_begin;
+
+        int newly_damaged = 0;
+        for (int i = 0; i < count; i++) {
+            uint16_t before = row[x_begin + i];
+            uint32_t sum = static_cast<uint32_t>(before) + damage_q[i];
+            row[x_begin + i] = sum > QUANTIZED_MAX ? QUANTIZED_MAX : static_cast<uint16_t>(sum);
+            newly_damaged += (before == 0) & (damage_q[i] != 0);
+        }
+        dense_count += newly_damaged;
+
+        uint32_t destroyed = 0;
+        for (int i = 0; i < count; i++) {
+            destroyed |= static_cast<uint32_t>(row[x_begin + i] == QUANTIZED_MAX) << (x_begin + i);
+        }
+
+        if (dense_count == 0) {
+            dense.reset();
+        }
+        return destroyed;
+    }
+
+    // Number of damaged blocks
+    inline size_t size() const { return dense ? dense_count : sparse.size(); }
+    inline bool empty() const { return size() == 0; }
+    inline bool is_dense() const { return dense != nullptr; }
+
+    void clear() {
+        sparse.release();
+        dense.reset();
+        dense_count = 0;
+    }
+
+    size_t get_memory_usage() const {
+        size_t dense_mem = dense ? sizeof(*dense) : 0;
+        return dense_mem + sparse.get_memory_usage();
+    }
+
+private:
+    // Sparse representation (few damaged blocks), keyed by local cell index
+    FlatHashMap<uint16_t, BlockHealth, IntegerHash> sparse;
+
+    // Dense representation, row-major (y * WIDTH + x)
+    std::unique_ptr<std::array<uint16_t, CELL_COUNT>> dense;
+    size_t dense_count;
+
+    static inline uint16_t index_of(Vector2i local_pos) {
+        return static_cast<uint16_t>(local_pos.y * WIDTH + local_pos.x);
+    }
+
+    static inline uint16_t health_to_quantized(float health, float max_health) {
+        if (health >= max_health) {
+            return 0;
+        }
+        if (health <= 0.0f) {
+            return QUANTIZED_MAX;
+        }
+        // Still alive - keep it below QUANTIZED_MAX so it doesn't read back as destroyed
+        uint16_t q = quantize_damage(max_health - health, max_health);
+        return q == QUANTIZED_MAX ? QUANTIZED_MAX - 1 : q;
+    }
+
+    inline void store_dense(size_t index, uint16_t q) {
+        uint16_t& cell = (*dense)[index];
+        dense_count += (cell == 0 && q != 0);
+        dense_count -= (cell != 0 && q == 0);
+        cell = q;
+
+        // Everything healed - drop back to the (empty) sparse map
+        if (dense_count == 0) {
+            dense.reset();
+        }
+    }
+
+    void promote_if_needed() {
+        if (sparse.size() >= DENSE_PROMOTE_THRESHOLD) {
+            make_dense();
+        }
+    }
+
+    void make_dense() {
+        if (dense) {
+            return;
+        }
+
+        dense = std::make_unique<std::array<uint16_t, CELL_COUNT>>();
+        dense->fill(0);
+        dense_count = 0;
+
+        for (const auto& [index, health] : sparse) {
+            uint16_t q = health_to_quantized(health.current_health, health.max_health);
+            uint16_t& cell = (*dense)[index];
+            dense_count += (cell == 0 && q != 0);
+            cell = q;
+        }
+        sparse.release();
+    }
+};
+
+#endif // CHUNK_HEALTH_H
@@ -0,0 +1,73 @@
+#ifndef CHUNK_LIQUID_H
+#define CHUNK_LIQUID_H
+
+#include "block_data.h"
+#include "world_constants.h"
+#include <godot_cpp/variant/vector2i.hpp>
+#include <array>
+#include <cstdint>
+
+using namespace godot;
+
+// Dense per-chunk liquid storage
+// Only chunks that currently hold liquid allocate a grid; Chunk2D keeps a null
+// pointer otherwise. Levels and types are separate row-major arrays so the
+// liquid solver can run whole 32-cell rows through branch-free kernels.
+//
+// Levels stay float: cells exceed 1.0 under pressure and the solver moves
+// amounts far below 1/256 of a tile while settling. Types fit in a byte.
+class ChunkLiquidGrid {
+public:
+    static constexpr int WIDTH = CHUNK_WIDTH;
+    static constexpr int HEIGHT = CHUNK_HEIGHT;
+    static constexpr int CELL_COUNT = WIDTH * HEIGHT;
+
+    // Liquid level per cell (0 = empty, 1.0 = full tile)
+    alignas(32) std::array<float, CELL_COUNT> level;
+
+    // LiquidType per cell (LIQUID_NONE where the level is 0)
+    std::array<uint8_t, CELL_COUNT> type;
+
+    ChunkLiquidGrid() {
+        level.fill(0.0f);
+        type.fill(LIQUID_NONE);
+    }
+
+    static inline int index_of(Vector2i local_pos) {
+        return local_pos.y * WIDTH + local_pos.x;
+    }
+
+    inline float* row_levels(int y) { return level.data() + y * WIDTH; }
+    inline const float* row_levels(int y) const { return level.data() + y * WIDTH; }
+    inline uint8_t* row_types(int y) { return type.data() + y * WIDTH; }
+    inline const uint8_t* row_types(int y) const { return type.data() + y * WIDTH; }
+
+    // Any liquid in row y
+    inline bool row_has_liquid(int y) const {
+        const float* row = row_levels(y);
+        bool any = false;
+        for (int x = 0; x < WIDTH; x++) {
+            any |= row[x] > 0.0f;
+        }
+        return any;
+    }
+
+    // True once every cell has drained (the grid can be released)
+    inline bool is_empty() const {
+        bool any = false;
+        for (int i = 0; i < CELL_COUNT; i++) {
+            any |= level[i] > 0.0f;
+        }
+        return !any;
+    }
+
+    inline size_t count_cells() const {
+        size_t count = 0;
+        for (int i = 0; i < CELL_COUNT; i++) {
+            count += level[i] > 0.0f ? 1 : 0;
+        }
+        return count;
+    }
+};
+
+#endif // CHUNK_LIQUID_H
@@ -0,0 +1,134 @@
+#ifndef CHUNK_OCCUPANCY_H
+#define CHUNK_OCCUPANCY_H
+
+#include "block_data.h"
+#include "world_constants.h"
+#include <array>
+#include <vector>
+#include <cstdint>
+
+using namespace godot;
+
+// Incremental summary of one chunk layer
+// Kept up to date by Chunk2D::set_block in O(1) (the type list holds the few
+// distinct types of a chunk), so systems can ask "is there anything / any
+// liquid / any of these types here" without scanning 1024 tiles:
+//   rows         - non-air tiles per row (bit x = column x)
+//   flag counts  - tiles per Block2D flag bit
+//   type counts  - tiles per block type present (compact histogram)
+class ChunkOccupancy {
+public:
+    static constexpr int WIDTH = CHUNK_WIDTH;
+    static constexpr int HEIGHT = CHUNK_HEIGHT;
+    static constexpr int FLAG_COUNT = 8;
+
+    struct TypeCount {
+        uint16_t type_id;
+        uint16_t count;
+    };
+
+private:
+    std::array<uint32_t, HEIGHT> rows;
+    std::array<uint16_t, FLAG_COUNT> flag_counts;
+    std::vector<TypeCount> type_counts;     // Unordered, no zero counts
+    uint16_t block_count;
+
+public:
+    ChunkOccupancy() { clear(); }
+
+    // Account for the tile at (x, y) changing from old_block to new_block
+    inline void replace(int x, int y, const Block2D& old_block, const Block2D& new_block) {
+        if (old_block.type_id != 0) {
+            remove_block(old_block);
+        }
+        if (new_block.type_id != 0) {
+            add_block(new_block);
+            rows[y] |= 1u << x;
+        } else {
+            rows[y] &= ~(1u << x);
+        }
+    }
+
+    inline bool is_empty() const { return block_count == 0; }
+    inline int get_block_count() const { return block_count; }
+
+    // Non-air tiles of row y
+    inline uint32_t get_row(int y) const { return rows[y]; }
+    inline const std::array<uint32_t, HEIGHT>& get_rows() const { return rows; }
+
+    // Tiles with a flag set (one Block2D::Flags bit)
+    inline int get_flag_count(Block2D::Flags flag) const {
+        for (int bit = 0; bit < FLAG_COUNT; bit++) {
+            if (flag == (1u << bit)) {
+                return flag_counts[bit];
+            }
+        }
+        return 0;
+    }
+
+    inline int get_type_count(uint16_t type_id) const {
+        for (const TypeCount& entry : type_counts) {
+            if (entry.type_id == type_id) {
+                return entry.count;
+            }
+        }
+        return 0;
+    }
+
+    inline const std::vector<TypeCount>& get_type_counts() const { return type_counts; }
+
+    // True if any type present has a non-zero entry in a per-type table
+    // (e.g. light emission, gravity); types past the table's end don't count
+    template <typename T>
+    inline bool has_any_type(const std::vector<T>& table) const {
+        for (const TypeCount& entry : type_counts) {
+            if (entry.type_id < table.size() && table[entry.type_id] != 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Heap memory of the type histogram
+    inline size_t get_memory_usage() const { return type_counts.capacity() * sizeof(TypeCount); }
+
+    inline void clear() {
+        rows.fill(0);
+        flag_counts.fill(0);
+        type_counts.clear();
+        block_count = 0;
+    }
+
+private:
+    inline void add_block(const Block2D& block) {
+        block_count++;
+        for (int bit = 0; bit < FLAG_COUNT; bit++) {
+            flag_counts[bit] += (block.flags >> bit) & 1u;
+        }
+        for (TypeCount& entry : type_counts) {
+            if (entry.type_id == block.type_id) {
+                entry.count++;
+                return;
+            }
+        }
+        type_counts.push_back({ block.type_id, 1 });
+    }
+
+    inline void remove_block(const Block2D& block) {
+        block_count--;
+        for (int bit = 0; bit < FLAG_COUNT; bit++) {
+            flag_counts[bit] -= (block.flags >> bit) & 1u;
+        }
+        for (size_t i = 0; i < type_counts.size(); i++) {
+            if (type_counts[i].type_id == block.type_id) {
+                if (--type_counts[i].count == 0) {
+                    type_counts[i] = type_counts.back();
+                    type_counts.pop_back();
+                }
+                return;
+            }
+        }
+    }
+};
+
+#endif // CHUNK_OCCUPANCY_H
@@ -23,15 +23,63 @@ constexpr int LAYER_UNDERGROUND_BOTTOM = 3000; // Bottom of underground (4900 bl
 constexpr int LAYER_UNDERWORLD_BOTTOM = 2000;  // Bottom of underworld (1000 blocks)
 constexpr int LAYER_DEEP_WORLD_BOTTOM = 0;     // Bottom of deep world (2000 blocks)
 
-// Chunk dimensions
-constexpr int CHUNK_WIDTH_BLOCKS = 32;
-constexpr int CHUNK_HEIGHT_BLOCKS = 32;
-constexpr int CHUNKS_HORIZONTAL = WORLD_WIDTH / CHUNK_WIDTH_BLOCKS;   // 50 chunks
-constexpr int CHUNKS_VERTICAL = WORLD_HEIGHT / CHUNK_HEIGHT_BLOCKS;   // 313 chunks (rounded up)
+// Chunk dimensions (powers of two, see TileGrid)
+constexpr int CHUNK_WIDTH = 32;
+constexpr int CHUNK_HEIGHT = 32;
+constexpr int CHUNK_SIZE = CHUNK_WIDTH * CHUNK_HEIGHT;
+constexpr int CHUNKS_HORIZONTAL = WORLD_WIDTH / CHUNK_WIDTH;    // 50 chunks
+constexpr int CHUNKS_VERTICAL = WORLD_HEIGHT / CHUNK_HEIGHT;    // 313 chunks (rounded up)
 
 // Tile rendering
 constexpr int TILE_SIZE_PIXELS = 16;       // Each block is 16x16 pixels
 
+// Tile / chunk coordinate math for ChunkW x ChunkH chunks in a world that
+// wraps every WorldW tiles horizontally
+// The chunk sizes are powers of two, so the floor division and modulo of
+// tile -> chunk / local are an arithmetic shift and a mask, correct for
+// negative (unwrapped) tiles too. These run on every tile lookup.
+template <int ChunkW, int ChunkH, int WorldW>
+struct TileGrid {
+    static_assert(ChunkW > 0 && (ChunkW & (ChunkW - 1)) == 0, "chunk width must be a power of two");
+    static_assert(ChunkH > 0 && (ChunkH & (ChunkH - 1)) == 0, "chunk height must be a power of two");
+    static_assert(WorldW % ChunkW == 0, "world width must be whole chunks");
+
+    static constexpr int log2(int value) { return value > 1 ? 1 + log2(value >> 1) : 0; }
+
+    static constexpr int SHIFT_X = log2(ChunkW);
+    static constexpr int SHIFT_Y = log2(ChunkH);
+    static constexpr int MASK_X = ChunkW - 1;
+    static constexpr int MASK_Y = ChunkH - 1;
+    static constexpr int CHUNKS_X = WorldW / ChunkW;
+
+    // Floor division by the chunk size (>> on negative ints is arithmetic on
+    // every compiler Godot supports, and guaranteed since C++20)
+    static constexpr int chunk_x(int tile_x) { return tile_x >> SHIFT_X; }
+    static constexpr int chunk_y(int tile_y) { return tile_y >> SHIFT_Y; }
+
+    // Position inside the chunk, 0..size-1 for negative tiles too
+    static constexpr int local_x(int tile_x) { return tile_x & MASK_X; }
+    static constexpr int local_y(int tile_y) { return tile_y & MASK_Y; }
+
+    // First tile of a chunk
+    static constexpr int origin_x(int chunk_x) { return chunk_x * ChunkW; }
+    static constexpr int origin_y(int chunk_y) { return chunk_y * ChunkH; }
+
+    // Wrap into 0..Count-1 for any int: the divisor is a constant, so the
+    // modulo compiles to a multiply and the sign fix to a conditional move
+    template <int Count>
+    static constexpr int wrap(int value) {
+        const int wrapped = value % Count;
+        return wrapped < 0 ? wrapped + Count : wrapped;
+    }
+
+    static constexpr int wrap_x(int tile_x) { return wrap<WorldW>(tile_x); }
+    static constexpr int wrap_chunk_x(int chunk_x) { return wrap<CHUNKS_X>(chunk_x); }
+};
+
+// Grid of the world: all tile <-> chunk conversions go through this
+using WorldGrid = TileGrid<CHUNK_WIDTH, CHUNK_HEIGHT, WORLD_WIDTH>;
+
 // Coordinate conversion utilities
 namespace WorldCoords {
     // Convert world position to tile position
@@ -52,36 +100,30 @@ namespace WorldCoords {
 
     // Convert tile position to chunk position
     inline Vector2i tile_to_chunk(Vector2i tile_pos) {
-        return Vector2i(
-            static_cast<int>(floor(static_cast<float>(tile_pos.x) / CHUNK_WIDTH_BLOCKS)),
-            static_cast<int>(floor(static_cast<float>(tile_pos.y) / CHUNK_HEIGHT_BLOCKS))
-        );
+        return Vector2i(WorldGrid::chunk_x(tile_pos.x), WorldGrid::chunk_y(tile_pos.y));
     }
 
     // Convert tile position to local position within chunk
     inline Vector2i tile_to_local(Vector2i tile_pos) {
-        int local_x = tile_pos.x % CHUNK_WIDTH_BLOCKS;
-        int local_y = tile_pos.y % CHUNK_HEIGHT_BLOCKS;
-
-        // Handle negative modulo
-        if (local_x < 0) local_x += CHUNK_WIDTH_BLOCKS;
-        if (local_y < 0) local_y += CHUNK_HEIGHT_BLOCKS;
-
-        return Vector2i(local_x, local_y);
+        return Vector2i(WorldGrid::local_x(tile_pos.x), WorldGrid::local_y(tile_pos.y));
     }
 
     // Convert chunk position and local position to tile position
     inline Vector2i chunk_local_to_tile(Vector2i chunk_pos, Vector2i local_pos) {
         return Vector2i(
-            chunk_pos.x * CHUNK_WIDTH_BLOCKS + local_pos.x,
-            chunk_pos.y * CHUNK_HEIGHT_BLOCKS + local_pos.y
+            WorldGrid::origin_x(chunk_pos.x) + local_pos.x,
+            WorldGrid::origin_y(chunk_pos.y) + local_pos.y
         );
     }
 
     // Wrap X coordinate for horizontal wrapping
     inline int wrap_x(int x) {
-        while (x < 0) x += WORLD_WIDTH;
-        return x % WORLD_WIDTH;
+        return WorldGrid::wrap_x(x);
+    }
+
+    // Wrap chunk X coordinate (50 chunks around)
+    inline Vector2i wrap_chunk_x(Vector2i chunk_pos) {
+        return Vector2i(WorldGrid::wrap_chunk_x(chunk_pos.x), chunk_pos.y);
     }
 
     // Wrap tile X coordinate
@@ -121,6 +163,12 @@ namespace WorldCoords {
     }
 }
 
+// Vertical axis in tile and pixel space: +Y points up, from bedrock (y = 0)
+// to space, as the layer table above and WorldGenerator lay the world out.
+// This is the opposite of Godot's 2D axes. Gravity, falling blocks, drops,
+// liquid flow and skylight all take "down" from here.
+constexpr int DOWN_Y = -1;
+
 // Physics constants
 constexpr float GRAVITY = 980.0f;           // Pixels per second squared
 constexpr float MAX_FALL_SPEED = 1000.0f;   // Max falling velocity
@@ -34,12 +34,19 @@ void WorldGenerator::generate_world() {
     // 4. Ores
     // 5. Caves (can't delete buildings)
     // 6. Background
+    // Generation rewrites the whole world - don't flood the change stream
+    BlockEventStream& events = chunk_manager->get_block_events();
+    bool events_enabled = events.is_enabled();
+    events.set_enabled(false);
+
     step1_generate_biomes();
     step2_place_buildings();  // NEW: Before terrain!
     step3_generate_terrain(); // Adapts to buildings
     step4_place_ores();
     step5_carve_caves();      // Protects building blocks
     step6_generate_background();
+
+    events.set_enabled(events_enabled);
 }
 
 void WorldGenerator::step1_generate_biomes() {
@@ -111,15 +118,14 @@ void WorldGenerator::step6_generate_background() {
         for (int y = 0; y < WORLD_HEIGHT; y++) {
             Vector2i pos(x, y);
 
-            const Block2D* fg = chunk_manager->get_block_at_tile(pos);
-            if (!fg) continue;
+            const uint16_t fg_type = chunk_manager->get_block_type_at_tile(pos);
 
             // Has foreground block - create matching background
-            if (fg->type_id != 0) {
-                const BlockDefinition* def = block_registry->get_block_definition(fg->type_id);
+            if (fg_type != 0) {
+                const BlockDefinition* def = block_registry->get_block_definition(fg_type);
                 if (def && def->can_be_background) {
                     Block2D bg_block;
-                    bg_block.type_id = fg->type_id; // Same as foreground
+                    bg_block.type_id = fg_type; // Same as foreground
                     chunk_manager->set_block_at_tile(pos, bg_block, true);
                 }
             }
@@ -199,8 +205,7 @@ void WorldGenerator::place_ores_in_column(int world_x, const BiomeDefinition* bi
             Vector2i ore_pos(world_x + ox, vein_y + oy);
 
             // Only replace stone with ore
-            const Block2D* existing = chunk_manager->get_block_at_tile(ore_pos);
-            if (existing && existing->type_id == biome->stone_block) {
+            if (chunk_manager->get_block_type_at_tile(ore_pos) == biome->stone_block) {
                 Block2D ore_block;
                 ore_block.type_id = ore_config.ore_id;
                 chunk_manager->set_block_at_tile(ore_pos, ore_block);
@@ -233,7 +238,7 @@ void CaveGenerator::carve_caves() {
             if (is_cave(x, y)) {
                 Vector2i pos(x, y);
 
-                const Block2D* existing = chunk_manager->get_block_at_tile(pos);
+                BlockView existing = chunk_manager->get_block_at_tile(pos);
                 if (!existing) continue;
 
                 const BlockDefinition* def = block_registry->get_block_definition(existing->type_id);
@@ -298,13 +303,13 @@ void CaveGenerator::generate_cave_background(int x, int y) {
     }
 
     // If foreground has ore, place ore in background too
-    const Block2D* fg = chunk_manager->get_block_at_tile(pos);
-    if (fg && fg->type_id != 0) {
-        const BlockDefinition* def = block_registry->get_block_definition(fg->type_id);
+    const uint16_t fg_type = chunk_manager->get_block_type_at_tile(pos);
+    if (fg_type != 0) {
+        const BlockDefinition* def = block_registry->get_block_definition(fg_type);
         if (def && def->is_ore && def->background_ore_priority) {
             // Keep ore in background
             Block2D bg_ore;
-            bg_ore.type_id = fg->type_id;
+            bg_ore.type_id = fg_type;
             chunk_manager->set_block_at_tile(pos, bg_ore, true);
         }
     }